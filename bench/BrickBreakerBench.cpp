@@ -0,0 +1,567 @@
+// 游戏热点的微基准：碰撞、关卡加载、配置、实体包围盒、砖块颜色、存档、HUD 文字
+// 每个用例先标定迭代次数（至少 --min-time 秒），再重复 --repetitions 次取最快的一次
+// 用法：BrickBreakerBench [--filter text] [--min-time seconds] [--repetitions n] [--json file|-] [--list]
+// JSON 与 Google Benchmark 的输出格式相同，可以直接用它的 compare.py 比较两次提交的结果
+#include "Entities/Ball.h"
+#include "Entities/Brick.h"
+#include "Entities/Paddle.h"
+#include "Managers/CollisionManager.h"
+#include "Managers/LevelGenerator.h"
+#include "Managers/LevelManager.h"
+#include "Managers/SaveSnapshot.h"
+#include "Utils/Config.h"
+#include "Utils/FrameArena.h"
+#include "Utils/Logger.h"
+#include "Utils/SaveService.h"
+#include "Utils/Utils.h"
+#include "LevelText.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    namespace fs = std::filesystem;
+    
+    // 用例主体：执行 iterations 次被测操作
+    using Body = std::function<void(std::uint64_t iterations)>;
+    
+    // 用例：setup 在真正运行时才调用（被过滤掉的用例不付出准备的代价）
+    struct Case {
+        std::string name;
+        std::uint64_t itemsPerIteration; // 每次迭代处理的元素数（砖块、配对等），0 表示不报告
+        std::function<Body()> setup;
+    };
+    
+    struct Result {
+        std::string name;
+        std::uint64_t iterations = 0;
+        double realNs = 0.0;   // 每次迭代
+        double cpuNs = 0.0;
+        double itemsPerSecond = 0.0;
+    };
+    
+    struct Options {
+        std::string filter;
+        std::string jsonFile;
+        double minTime = 0.2;
+        int repetitions = 3;
+        bool list = false;
+    };
+    
+    // 结果写到这里，防止编译器把被测代码当成无用计算删掉
+    volatile double sink = 0.0;
+    
+    const sf::Vector2u windowSize(800, 600);
+    const sf::Vector2f levelPosition(50.0f, 50.0f);
+    const sf::Vector2f levelSize(700.0f, 200.0f);
+    
+    LevelGenerator::Params gridParams(int rows, int columns, float density) {
+        LevelGenerator::Params params;
+        params.seed = 12345;
+        params.rows = rows;
+        params.columns = columns;
+        params.density = density;
+        return params;
+    }
+    
+    // 满密度的方形网格：count 为 100/1000/10000 时分别是 10x10、25x40、100x100
+    LevelGenerator::Params fullGrid(int count) {
+        int rows = static_cast<int>(std::sqrt(static_cast<double>(count)));
+        while (count % rows != 0) --rows;
+        return gridParams(rows, count / rows, 1.0f);
+    }
+    
+    void addCollisionCases(std::vector<Case>& cases) {
+        for (int brickCount : {100, 1000, 10000}) {
+            for (int ballCount : {1, 5, 50}) {
+                std::string name = "collision/update/balls:" + std::to_string(ballCount) +
+                                   "/bricks:" + std::to_string(brickCount);
+                cases.push_back({name, static_cast<std::uint64_t>(ballCount) * brickCount, [brickCount, ballCount]() -> Body {
+                    struct State {
+                        LevelManager levels;
+                        BrickList bricks;
+                        std::vector<std::unique_ptr<Ball>> balls;
+                        std::unique_ptr<Paddle> paddle;
+                        std::unique_ptr<CollisionManager> collisions;
+                    };
+                    auto state = std::make_shared<State>();
+                    state->levels.init({}, levelPosition, levelSize);
+                    state->bricks = state->levels.generateLevel(fullGrid(brickCount));
+                    
+                    // 球停在砖块区和挡板之间：每个球都要扫完全部砖块（最坏情况），每次迭代的工作量相同
+                    for (int i = 0; i < ballCount; ++i) {
+                        float x = 60.0f + static_cast<float>(i) * (680.0f / static_cast<float>(ballCount));
+                        auto ball = std::make_unique<Ball>(sf::Vector2f(x, 400.0f), 10.0f);
+                        ball->setVelocity(sf::Vector2f(0.0f, -300.0f));
+                        state->balls.push_back(std::move(ball));
+                    }
+                    state->paddle = std::make_unique<Paddle>(sf::Vector2f(350.0f, 550.0f), sf::Vector2f(100.0f, 20.0f));
+                    state->collisions = std::make_unique<CollisionManager>(windowSize);
+                    
+                    return [state](std::uint64_t iterations) {
+                        for (std::uint64_t i = 0; i < iterations; ++i) {
+                            FrameArena::getInstance()->reset();
+                            state->collisions->update(state->balls, state->paddle.get(), state->bricks);
+                        }
+                        sink = sink + state->collisions->getDestroyedBricks().size();
+                    };
+                }});
+            }
+        }
+    }
+    
+    void addLevelCases(std::vector<Case>& cases, const fs::path& directory) {
+        struct Size {
+            const char* name;
+            int rows;
+            int columns;
+        };
+        // small 与 resources/levels 中的关卡相当
+        for (Size size : {Size{"small", 8, 10}, Size{"large", 100, 100}}) {
+            const LevelGenerator::Params params = gridParams(size.rows, size.columns, 0.8f);
+            std::vector<LevelFormat::BrickRecord> records;
+            LevelGenerator::generate(params, records);
+            const std::uint64_t brickCount = records.size();
+            
+            // 文本关卡旁边没有 .bbl，编译关卡只有 .bbl（init 传入的 .txt 不存在）
+            const std::string textFile = (directory / (std::string("text_") + size.name + ".txt")).string();
+            const std::string compiledSource = (directory / (std::string("compiled_") + size.name + ".txt")).string();
+            
+            cases.push_back({std::string("level/load/text/") + size.name, brickCount, [textFile, params, records]() -> Body {
+                std::ofstream(textFile, std::ios::binary) << LevelText::render(params.rows, params.columns, records, "BrickBreakerBench");
+                auto levels = std::make_shared<LevelManager>();
+                levels->init({textFile}, levelPosition, levelSize);
+                return [levels](std::uint64_t iterations) {
+                    for (std::uint64_t i = 0; i < iterations; ++i) {
+                        sink = sink + levels->loadLevel(0).size();
+                    }
+                };
+            }});
+            
+            cases.push_back({std::string("level/load/compiled/") + size.name, brickCount, [compiledSource, params, records]() -> Body {
+                LevelFormat::writeFile(LevelFormat::compiledPath(compiledSource), params.rows, params.columns,
+                                       records.data(), records.size());
+                auto levels = std::make_shared<LevelManager>();
+                levels->init({compiledSource}, levelPosition, levelSize);
+                return [levels](std::uint64_t iterations) {
+                    for (std::uint64_t i = 0; i < iterations; ++i) {
+                        sink = sink + levels->loadLevel(0).size();
+                    }
+                };
+            }});
+            
+            cases.push_back({std::string("level/load/generated/") + size.name, brickCount, [params]() -> Body {
+                auto levels = std::make_shared<LevelManager>();
+                levels->init({}, levelPosition, levelSize);
+                return [levels, params](std::uint64_t iterations) {
+                    for (std::uint64_t i = 0; i < iterations; ++i) {
+                        sink = sink + levels->generateLevel(params).size();
+                    }
+                };
+            }});
+        }
+    }
+    
+    void addConfigCases(std::vector<Case>& cases, const fs::path& directory) {
+        const std::string configFile = (directory / "config.ini").string();
+        
+        cases.push_back({"config/save", 0, [configFile]() -> Body {
+            return [configFile](std::uint64_t iterations) {
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    Config::getInstance().save(configFile);
+                }
+            };
+        }});
+        
+        cases.push_back({"config/load", 0, [configFile]() -> Body {
+            Config::getInstance().save(configFile);
+            return [configFile](std::uint64_t iterations) {
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    Config::getInstance().load(configFile);
+                }
+            };
+        }});
+        
+        // 配置表中的键和配置表之外的键走不同的查找路径
+        cases.push_back({"config/get_value/table", 0, []() -> Body {
+            return [](std::uint64_t iterations) {
+                const std::string key = "game.ball_speed";
+                float total = 0.0f;
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    total += Config::getInstance().getValue<float>(key, 0.0f);
+                }
+                sink = sink + total;
+            };
+        }});
+        
+        cases.push_back({"config/get_value/extra", 0, []() -> Body {
+            Config::getInstance().setValue<int>("bench.extra_value", 7);
+            return [](std::uint64_t iterations) {
+                const std::string key = "bench.extra_value";
+                int total = 0;
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    total += Config::getInstance().getValue<int>(key, 0);
+                }
+                sink = sink + total;
+            };
+        }});
+    }
+    
+    void addEntityCases(std::vector<Case>& cases) {
+        const std::uint64_t brickCount = 1000;
+        
+        // 没有纹理时直接返回位置和尺寸，有精灵时走 sf::Sprite::getGlobalBounds
+        for (bool withSprite : {false, true}) {
+            std::string name = withSprite ? "entity/get_bounds/sprite" : "entity/get_bounds/plain";
+            cases.push_back({name, brickCount, [withSprite, brickCount]() -> Body {
+                struct State {
+                    sf::Texture texture; // 空纹理：精灵只保存指针，不需要图形上下文
+                    BrickList bricks;
+                };
+                auto state = std::make_shared<State>();
+                state->bricks.reserve(brickCount);
+                for (std::uint64_t i = 0; i < brickCount; ++i) {
+                    Brick* brick = state->bricks.create(sf::Vector2f(static_cast<float>(i % 40) * 17.0f, static_cast<float>(i / 40) * 8.0f),
+                                                        sf::Vector2f(16.0f, 7.0f), 1, 100);
+                    if (withSprite) {
+                        brick->setTexture(state->texture);
+                    }
+                }
+                return [state](std::uint64_t iterations) {
+                    float total = 0.0f;
+                    for (std::uint64_t i = 0; i < iterations; ++i) {
+                        for (Brick* brick : state->bricks) {
+                            total += brick->getBounds().position.x;
+                        }
+                    }
+                    sink = sink + total;
+                };
+            }});
+        }
+        
+        // updateColorFromHitPoints 是私有的，通过 setHitPoints 调用（每次读取配置中的颜色）
+        cases.push_back({"brick/update_color", brickCount, [brickCount]() -> Body {
+            auto bricks = std::make_shared<BrickList>();
+            bricks->reserve(brickCount);
+            for (std::uint64_t i = 0; i < brickCount; ++i) {
+                bricks->create(sf::Vector2f(static_cast<float>(i), 0.0f), sf::Vector2f(16.0f, 7.0f), 1, 100);
+            }
+            return [bricks](std::uint64_t iterations) {
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    int hitPoints = static_cast<int>(i % 3) + 1;
+                    for (Brick* brick : *bricks) {
+                        brick->setHitPoints(hitPoints);
+                    }
+                }
+                sink = sink + (*bricks)[0]->getHitPoints();
+            };
+        }});
+    }
+    
+    // 与 PlayState::fillSnapshot 相同的内容
+    void fillSnapshot(SaveSnapshot& snapshot, std::uint32_t brickCount, int ballCount) {
+        snapshot.score = 12340;
+        snapshot.lives = 3;
+        snapshot.level = 2;
+        snapshot.ballLaunched = true;
+        snapshot.paddleX = 350.0f;
+        snapshot.paddleY = 550.0f;
+        snapshot.rngState = 0x9E3779B97F4A7C15ull;
+        snapshot.generation = 1;
+        snapshot.balls.clear();
+        for (int i = 0; i < ballCount; ++i) {
+            snapshot.balls.push_back({100.0f + static_cast<float>(i), 300.0f, 150.0f, -250.0f});
+        }
+        snapshot.setBrickCount(brickCount);
+        for (std::uint32_t i = 0; i < brickCount; ++i) {
+            snapshot.setBrickActive(i, i % 3 != 0);
+        }
+    }
+    
+    void addSaveCases(std::vector<Case>& cases, const fs::path& directory) {
+        struct Size {
+            const char* name;
+            std::uint32_t bricks;
+            int balls;
+        };
+        for (Size size : {Size{"level", 80, 3}, Size{"large", 10000, 1000}}) {
+            cases.push_back({std::string("save/serialize/") + size.name, 0, [size]() -> Body {
+                auto snapshot = std::make_shared<SaveSnapshot>();
+                fillSnapshot(*snapshot, size.bricks, size.balls);
+                auto buffer = std::make_shared<std::vector<unsigned char>>();
+                return [snapshot, buffer](std::uint64_t iterations) {
+                    for (std::uint64_t i = 0; i < iterations; ++i) {
+                        snapshot->serialize(*buffer);
+                    }
+                    sink = sink + buffer->size();
+                };
+            }});
+            
+            cases.push_back({std::string("save/deserialize/") + size.name, 0, [size]() -> Body {
+                SaveSnapshot source;
+                fillSnapshot(source, size.bricks, size.balls);
+                auto buffer = std::make_shared<std::vector<unsigned char>>();
+                source.serialize(*buffer);
+                auto snapshot = std::make_shared<SaveSnapshot>();
+                return [snapshot, buffer](std::uint64_t iterations) {
+                    for (std::uint64_t i = 0; i < iterations; ++i) {
+                        sink = sink + snapshot->deserialize(buffer->data(), buffer->size());
+                    }
+                };
+            }});
+        }
+        
+        // 整个存档流程：序列化、临时文件 + fsync + 重命名、读回（主要是磁盘的开销）
+        const std::string saveFile = (directory / "savegame.dat").string();
+        cases.push_back({"save/round_trip_file/level", 0, [saveFile]() -> Body {
+            auto snapshot = std::make_shared<SaveSnapshot>();
+            fillSnapshot(*snapshot, 80, 3);
+            return [snapshot, saveFile](std::uint64_t iterations) {
+                std::vector<unsigned char> buffer;
+                SaveSnapshot loaded;
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    snapshot->serialize(buffer);
+                    SaveService::writeAtomically(saveFile, buffer.data(), buffer.size());
+                    sink = sink + loaded.loadFromFile(saveFile);
+                }
+            };
+        }});
+    }
+    
+    void addHudCases(std::vector<Case>& cases) {
+        // 与 PlayState::updateUI 相同：格式化到已有的 sf::String
+        cases.push_back({"hud/format", 0, []() -> Body {
+            auto text = std::make_shared<sf::String>();
+            return [text](std::uint64_t iterations) {
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    Utils::String::formatTo(*text, "Score: %d", static_cast<int>(i));
+                }
+                sink = sink + text->getSize();
+            };
+        }});
+        
+        // 再设置到 sf::Text（只标记几何需要重建，字形在绘制时生成）；没有字体时跳过
+        cases.push_back({"hud/set_string", 0, []() -> Body {
+            struct State {
+                sf::Font font;
+                std::unique_ptr<sf::Text> text;
+                sf::String string;
+            };
+            auto state = std::make_shared<State>();
+            if (!state->font.openFromFile("resources/fonts/arial.ttf")) {
+                return Body();
+            }
+            state->text = std::make_unique<sf::Text>(state->font, "Score: 0", 24);
+            return [state](std::uint64_t iterations) {
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    Utils::String::formatTo(state->string, "Score: %d", static_cast<int>(i));
+                    state->text->setString(state->string);
+                }
+                sink = sink + state->text->getString().getSize();
+            };
+        }});
+    }
+    
+    // 进程 CPU 时间（秒）
+    double cpuSeconds() {
+        return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+    }
+    
+    // 标定迭代次数直到一次运行至少 minTime 秒，再重复 repetitions 次取最快的一次
+    Result measure(const Case& benchmark, const Body& body, const Options& options) {
+        std::uint64_t iterations = 1;
+        double seconds = 0.0;
+        for (;;) {
+            auto start = std::chrono::steady_clock::now();
+            body(iterations);
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (seconds >= options.minTime || iterations >= (1ull << 40)) {
+                break;
+            }
+            
+            // 按已测的速度估算，多留 40%，一次最多放大 10 倍
+            double estimate = seconds > 0.0 ? options.minTime / seconds * 1.4 * static_cast<double>(iterations)
+                                            : static_cast<double>(iterations) * 10.0;
+            iterations = std::max(iterations + 1,
+                                  std::min(iterations * 10, static_cast<std::uint64_t>(estimate)));
+        }
+        
+        Result result;
+        result.name = benchmark.name;
+        result.iterations = iterations;
+        for (int repetition = 0; repetition < options.repetitions; ++repetition) {
+            auto start = std::chrono::steady_clock::now();
+            double cpuStart = cpuSeconds();
+            body(iterations);
+            double real = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            double cpu = cpuSeconds() - cpuStart;
+            
+            double realNs = real * 1.0e9 / static_cast<double>(iterations);
+            if (repetition == 0 || realNs < result.realNs) {
+                result.realNs = realNs;
+                result.cpuNs = cpu * 1.0e9 / static_cast<double>(iterations);
+            }
+        }
+        if (benchmark.itemsPerIteration > 0) {
+            result.itemsPerSecond = static_cast<double>(benchmark.itemsPerIteration) * 1.0e9 / result.realNs;
+        }
+        return result;
+    }
+    
+    std::string escapeJson(const std::string& text) {
+        std::string out;
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+            }
+            out += c;
+        }
+        return out;
+    }
+    
+    // Google Benchmark 的 JSON 格式，每个用例一行，方便直接 diff
+    void writeJson(std::ostream& out, const std::vector<Result>& results, const char* executable, const Options& options) {
+        char date[64];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+        
+        out << "{\n";
+        out << "  \"context\": {\n";
+        out << "    \"date\": \"" << date << "\",\n";
+        out << "    \"executable\": \"" << escapeJson(executable) << "\",\n";
+        out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+        out << "    \"min_time\": " << options.minTime << ",\n";
+        out << "    \"repetitions\": " << options.repetitions << ",\n";
+#ifdef NDEBUG
+        out << "    \"library_build_type\": \"release\"\n";
+#else
+        out << "    \"library_build_type\": \"debug\"\n";
+#endif
+        out << "  },\n";
+        out << "  \"benchmarks\": [\n";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const Result& result = results[i];
+            char numbers[256];
+            std::snprintf(numbers, sizeof(numbers),
+                          "\"iterations\": %llu, \"real_time\": %.3f, \"cpu_time\": %.3f, \"time_unit\": \"ns\"",
+                          static_cast<unsigned long long>(result.iterations), result.realNs, result.cpuNs);
+            out << "    {\"name\": \"" << escapeJson(result.name) << "\", \"run_name\": \"" << escapeJson(result.name)
+                << "\", \"run_type\": \"iteration\", " << numbers;
+            if (result.itemsPerSecond > 0.0) {
+                std::snprintf(numbers, sizeof(numbers), ", \"items_per_second\": %.1f", result.itemsPerSecond);
+                out << numbers;
+            }
+            out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n";
+        out << "}\n";
+    }
+    
+    bool parseOptions(int argc, char* argv[], Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--filter" && hasValue) {
+                options.filter = argv[++i];
+            } else if (arg == "--json" && hasValue) {
+                options.jsonFile = argv[++i];
+            } else if (arg == "--min-time" && hasValue) {
+                options.minTime = std::max(std::atof(argv[++i]), 0.001);
+            } else if (arg == "--repetitions" && hasValue) {
+                options.repetitions = std::max(std::atoi(argv[++i]), 1);
+            } else if (arg == "--list") {
+                options.list = true;
+            } else {
+                std::cerr << "Usage: " << argv[0]
+                          << " [--filter text] [--min-time seconds] [--repetitions n] [--json file|-] [--list]" << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 2;
+    }
+    
+    // 被测代码中的 info 日志（每次加载关卡、配置）不输出
+    Logger::getInstance()->setLevel(Logger::Warning);
+    
+    const fs::path directory = fs::temp_directory_path() / "brickbreaker-bench";
+    std::error_code error;
+    fs::create_directories(directory, error);
+    
+    std::vector<Case> cases;
+    addCollisionCases(cases);
+    addLevelCases(cases, directory);
+    addConfigCases(cases, directory);
+    addEntityCases(cases);
+    addSaveCases(cases, directory);
+    addHudCases(cases);
+    
+    // JSON 写到标准输出时表格改到标准错误
+    const bool jsonToStdout = options.jsonFile == "-";
+    std::ostream& table = jsonToStdout ? std::cerr : std::cout;
+    
+    std::vector<Result> results;
+    for (const Case& benchmark : cases) {
+        if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        if (options.list) {
+            std::cout << benchmark.name << std::endl;
+            continue;
+        }
+        
+        Body body = benchmark.setup();
+        if (!body) {
+            table << benchmark.name << ": skipped" << std::endl;
+            continue;
+        }
+        Result result = measure(benchmark, body, options);
+        results.push_back(result);
+        
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-44s %14.1f ns %14.1f ns cpu %12llu",
+                      result.name.c_str(), result.realNs, result.cpuNs, static_cast<unsigned long long>(result.iterations));
+        table << line;
+        if (result.itemsPerSecond > 0.0) {
+            std::snprintf(line, sizeof(line), "  %10.2f M items/s", result.itemsPerSecond / 1.0e6);
+            table << line;
+        }
+        table << std::endl;
+    }
+    
+    if (!options.jsonFile.empty() && !options.list) {
+        if (jsonToStdout) {
+            writeJson(std::cout, results, argv[0], options);
+        } else {
+            std::ofstream file(options.jsonFile);
+            writeJson(file, results, argv[0], options);
+            if (!file) {
+                std::cerr << "Cannot write " << options.jsonFile << std::endl;
+                return 1;
+            }
+        }
+    }
+    
+    fs::remove_all(directory, error);
+    Logger::getInstance()->shutdown();
+    return 0;
+}
@@ -0,0 +1,85 @@
+// 配置解析吞吐量基准：生成一个大 ini 文件，反复加载和保存并报告 MB/s 和 行/s
+// 用法：ConfigParseBench [lines] [iterations]
+#include "Utils/Config.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace {
+    // 配置表中的键反复出现（模拟多次追加的旧存档），其余是配置表之外的键
+    std::size_t writeConfigFile(const std::string& filename, int lines) {
+        static const char* knownLines[] = {
+            "game.ball_speed = 400",
+            "game.paddle_speed = 400",
+            "colors.background = 20,20,50,255",
+            "window.title = BrickBreaker",
+            "sound.music_fade = 1.5",
+            "window.vsync = true",
+        };
+        const int knownCount = static_cast<int>(sizeof(knownLines) / sizeof(knownLines[0]));
+        
+        std::ofstream file(filename, std::ios::binary);
+        file << "# generated by ConfigParseBench\n";
+        for (int i = 0; i < lines; ++i) {
+            if (i % 2 == 0) {
+                file << knownLines[(i / 2) % knownCount] << "\n";
+            } else {
+                switch (i % 3) {
+                    case 0: file << "bench.int" << i << " = " << i << "\n"; break;
+                    case 1: file << "bench.float" << i << " = " << i << ".25\n"; break;
+                    default: file << "file.bench" << i << " = resources/bench/" << i << ".png\n"; break;
+                }
+            }
+        }
+        return static_cast<std::size_t>(file.tellp());
+    }
+    
+    template<typename Fn>
+    void measure(const char* name, int iterations, double megabytes, int lines, Fn&& fn) {
+        double bestSeconds = 0.0;
+        double totalSeconds = 0.0;
+        for (int i = 0; i < iterations; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            totalSeconds += seconds;
+            bestSeconds = (i == 0 || seconds < bestSeconds) ? seconds : bestSeconds;
+        }
+        std::cout << name << ": best " << bestSeconds * 1000.0 << " ms (" << megabytes / bestSeconds << " MB/s, "
+                  << lines / bestSeconds / 1.0e6 << " M lines/s), mean "
+                  << totalSeconds / iterations * 1000.0 << " ms over " << iterations << " iterations" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const int lines = argc > 1 ? std::atoi(argv[1]) : 100000;
+    const int iterations = argc > 2 ? std::atoi(argv[2]) : 10;
+    const std::string input = "config_bench.ini";
+    const std::string output = "config_bench_out.ini";
+    
+    const double megabytes = writeConfigFile(input, lines) / (1024.0 * 1024.0);
+    std::cout << "Config file: " << lines << " lines, " << megabytes << " MB" << std::endl;
+    
+    Config& config = Config::getInstance();
+    
+    // 第一次加载会为配置表之外的键分配节点，之后的加载只覆盖已有的值
+    measure("load", iterations, megabytes, lines, [&]() {
+        if (!config.load(input)) {
+            std::cerr << "Failed to load " << input << std::endl;
+            std::exit(1);
+        }
+    });
+    measure("save", iterations, megabytes, lines, [&]() {
+        if (!config.save(output)) {
+            std::cerr << "Failed to save " << output << std::endl;
+            std::exit(1);
+        }
+    });
+    
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+    return 0;
+}
@@ -0,0 +1,103 @@
+// 关卡砖块的加载和释放基准：每块砖单独分配（std::unique_ptr）与关卡分配器（BrickList）对比
+// 用法：LevelArenaBench [iterations] [brickCount...]，默认 1000 10000 100000 块
+#include "Entities/BrickList.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+    struct Timing {
+        double bestLoad = 0.0;
+        double bestUnload = 0.0;
+    };
+    
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+    // 与 LevelManager::buildBricks 相同的创建步骤：构造、设颜色、设纹理（创建精灵）
+    template<typename Create>
+    void buildGrid(std::size_t count, const sf::Texture& texture, Create&& create) {
+        const std::size_t columns = 100;
+        for (std::size_t i = 0; i < count; ++i) {
+            Brick* brick = create(sf::Vector2f(static_cast<float>(i % columns) * 8.0f, static_cast<float>(i / columns) * 4.0f),
+                                  sf::Vector2f(7.0f, 3.0f), static_cast<int>(i % 3) + 1, 100);
+            brick->setColor(sf::Color::Blue);
+            brick->setTexture(texture);
+        }
+    }
+    
+    template<typename Fn>
+    void keepBest(double& best, int iteration, Fn&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        double seconds = secondsSince(start);
+        best = (iteration == 0 || seconds < best) ? seconds : best;
+    }
+    
+    Timing measureHeap(std::size_t count, int iterations, const sf::Texture& texture) {
+        Timing timing;
+        for (int i = 0; i < iterations; ++i) {
+            std::vector<std::unique_ptr<Brick>> bricks;
+            keepBest(timing.bestLoad, i, [&]() {
+                bricks.reserve(count);
+                buildGrid(count, texture, [&](const sf::Vector2f& position, const sf::Vector2f& size, int hitPoints, int score) {
+                    bricks.push_back(std::make_unique<Brick>(position, size, hitPoints, score));
+                    return bricks.back().get();
+                });
+            });
+            keepBest(timing.bestUnload, i, [&]() {
+                bricks.clear();
+                bricks.shrink_to_fit();
+            });
+        }
+        return timing;
+    }
+    
+    Timing measureArena(std::size_t count, int iterations, const sf::Texture& texture) {
+        Timing timing;
+        for (int i = 0; i < iterations; ++i) {
+            BrickList bricks;
+            keepBest(timing.bestLoad, i, [&]() {
+                bricks.reserve(count);
+                buildGrid(count, texture, [&](const sf::Vector2f& position, const sf::Vector2f& size, int hitPoints, int score) {
+                    return bricks.create(position, size, hitPoints, score);
+                });
+            });
+            keepBest(timing.bestUnload, i, [&]() {
+                bricks = BrickList();
+            });
+        }
+        return timing;
+    }
+    
+    void report(const char* name, std::size_t count, const Timing& timing) {
+        std::cout << "  " << name << ": load " << timing.bestLoad * 1000.0 << " ms ("
+                  << timing.bestLoad * 1.0e9 / count << " ns/brick), unload " << timing.bestUnload * 1000.0 << " ms ("
+                  << timing.bestUnload * 1.0e9 / count << " ns/brick)" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const int iterations = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 20;
+    std::vector<std::size_t> counts;
+    for (int i = 2; i < argc; ++i) {
+        counts.push_back(static_cast<std::size_t>(std::atoll(argv[i])));
+    }
+    if (counts.empty()) {
+        counts = {1000, 10000, 100000};
+    }
+    
+    // 空纹理：精灵只保存指针，不需要图形上下文
+    sf::Texture texture;
+    
+    for (std::size_t count : counts) {
+        std::cout << count << " bricks (best of " << iterations << "):" << std::endl;
+        report("heap ", count, measureHeap(count, iterations, texture));
+        report("arena", count, measureArena(count, iterations, texture));
+    }
+    return 0;
+}
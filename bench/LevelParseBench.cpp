@@ -0,0 +1,50 @@
+// 关卡解析吞吐量基准：生成一个大文本关卡，反复解析并报告 MB/s 和 砖块/s
+// 用法：LevelParseBench [rows] [columns] [iterations]
+#include "Managers/LevelGenerator.h"
+#include "Managers/LevelParser.h"
+#include "LevelText.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    LevelGenerator::Params params;
+    params.seed = 12345;
+    params.rows = argc > 1 ? std::atoi(argv[1]) : 2000;
+    params.columns = argc > 2 ? std::atoi(argv[2]) : 2000;
+    const int iterations = argc > 3 ? std::atoi(argv[3]) : 10;
+
+    std::vector<LevelFormat::BrickRecord> generated;
+    LevelGenerator::generate(params, generated);
+    const std::string text = LevelText::render(params.rows, params.columns, generated, "LevelParseBench");
+
+    LevelParser::Layout layout;
+    LevelParser::Error error;
+    double bestSeconds = 0.0;
+    double totalSeconds = 0.0;
+
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        if (!LevelParser::parse(text.data(), text.size(), layout, error)) {
+            std::cerr << "Parse error at " << error.line << ":" << error.column << ": " << error.message << std::endl;
+            return 1;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        totalSeconds += seconds;
+        bestSeconds = (i == 0 || seconds < bestSeconds) ? seconds : bestSeconds;
+    }
+
+    if (layout.records.size() != generated.size()) {
+        std::cerr << "Brick count mismatch: " << layout.records.size() << " != " << generated.size() << std::endl;
+        return 1;
+    }
+
+    const double megabytes = static_cast<double>(text.size()) / (1024.0 * 1024.0);
+    std::cout << "Level " << layout.rows << "x" << layout.columns << ", " << layout.records.size()
+              << " bricks, " << megabytes << " MB" << std::endl;
+    std::cout << "best " << bestSeconds * 1000.0 << " ms (" << megabytes / bestSeconds << " MB/s, "
+              << layout.records.size() / bestSeconds / 1.0e6 << " M bricks/s)" << std::endl;
+    std::cout << "mean " << totalSeconds / iterations * 1000.0 << " ms over " << iterations << " iterations" << std::endl;
+    return 0;
+}
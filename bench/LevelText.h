@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Managers/LevelFormat.h"
+
+// 基准程序共用：把生成的砖块记录写成文本关卡（带 size 头部），作为 LevelParser 的输入
+namespace LevelText {
+    inline std::string render(int rows, int columns, const std::vector<LevelFormat::BrickRecord>& records,
+                              const std::string& generator) {
+        std::string grid(static_cast<std::size_t>(rows) * (columns + 1), '.');
+        for (int row = 0; row < rows; ++row) {
+            grid[static_cast<std::size_t>(row) * (columns + 1) + columns] = '\n';
+        }
+        for (const auto& record : records) {
+            grid[static_cast<std::size_t>(record.row) * (columns + 1) + record.column] =
+                static_cast<char>('0' + record.hitPoints);
+        }
+        return "# generated by " + generator + "\nsize " + std::to_string(rows) + " " + std::to_string(columns) + "\n" + grid;
+    }
+}
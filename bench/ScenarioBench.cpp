@@ -0,0 +1,471 @@
+// 端到端场景基准：不开窗口（Game::initHeadless），按固定步长和固定种子驱动真正的 PlayState，挡板由自动挡板控制；
+// 报告每帧耗时的分位数、每秒模拟帧数、峰值内存和分配次数，并与 scenario_thresholds.ini 中的上限比较
+// 用法：ScenarioBench [--scenario text] [--thresholds file] [--json file|-] [--seed n] [--list]
+// 超出任一上限时返回 1（用法或场景准备出错时返回 2）
+#include "Game.h"
+#include "States/PlayState.h"
+#include "Managers/LevelGenerator.h"
+#include "Managers/SaveSnapshot.h"
+#include "Utils/AllocTracker.h"
+#include "Utils/Logger.h"
+#include "Utils/SaveService.h"
+#include "Utils/Utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+    namespace fs = std::filesystem;
+    
+    const float tickSeconds = 1.0f / 60.0f;
+    const sf::Vector2u windowSize(800, 600);
+    
+    // 掉落的球从挡板上方补发，场景中的球数保持不变
+    void keepBalls(PlayState& play, std::size_t count) {
+        while (play.getBallCount() < count) {
+            play.addBall();
+        }
+    }
+    
+    // 场景：setup 在新的一局上准备局面（不计时），tick 执行一个计时单位
+    struct Scenario {
+        const char* name;
+        const char* description;
+        int ticks;
+        float simulatedSecondsPerTick;           // 存档场景不推进游戏时间
+        std::function<bool(Game&, PlayState&)> setup;
+        std::function<void(Game&, PlayState&)> tick;
+    };
+    
+    struct Report {
+        std::string name;
+        int ticks = 0;
+        double simulatedSeconds = 0.0;
+        double wallSeconds = 0.0;
+        double ticksPerSecond = 0.0;
+        double p50 = 0.0;
+        double p90 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+        double peakRssMb = 0.0;
+        bool allocationsCounted = false;
+        std::uint64_t allocations = 0;
+        std::uint64_t allocatedBytes = 0;
+        double allocationsPerTick = 0.0;
+        int score = 0;
+        std::uint64_t bricksDestroyed = 0;
+        std::uint64_t ballsLost = 0;
+        std::uint64_t levelsCleared = 0;
+        
+        struct Check {
+            std::string metric;
+            double limit;
+            double value;
+            bool passed;
+        };
+        std::vector<Check> checks;
+        bool passed = true;
+    };
+    
+    struct Options {
+        std::string filter;
+        std::string thresholdsFile = "scenario_thresholds.ini";
+        std::string jsonFile;
+        std::uint64_t seed = 1;
+        bool list = false;
+    };
+    
+    std::vector<Scenario> makeScenarios(const fs::path& directory) {
+        std::vector<Scenario> scenarios;
+        
+        scenarios.push_back({"level3_5balls", "level 3 with 5 balls for 60 simulated seconds", 60 * 60, tickSeconds,
+            [](Game&, PlayState& play) {
+                if (!play.startLevel(2)) return false;
+                keepBalls(play, 5);
+                return true;
+            },
+            [](Game& game, PlayState& play) {
+                game.simulate(tickSeconds);
+                keepBalls(play, 5);
+            }});
+        
+        scenarios.push_back({"generated_10k", "generated 100x100 level (10k bricks), 5 balls for 30 simulated seconds", 30 * 60, tickSeconds,
+            [](Game&, PlayState& play) {
+                LevelGenerator::Params params;
+                params.seed = 42;
+                params.rows = 100;
+                params.columns = 100;
+                params.density = 1.0f;
+                if (!play.startGeneratedLevel(params)) return false;
+                keepBalls(play, 5);
+                return true;
+            },
+            [](Game& game, PlayState& play) {
+                game.simulate(tickSeconds);
+                keepBalls(play, 5);
+            }});
+        
+        scenarios.push_back({"chaos_1000_balls", "1,000 balls on level 3 for 10 simulated seconds", 10 * 60, tickSeconds,
+            [](Game&, PlayState& play) {
+                if (!play.startLevel(2)) return false;
+                keepBalls(play, 1000);
+                return true;
+            },
+            [](Game& game, PlayState& play) {
+                game.simulate(tickSeconds);
+                keepBalls(play, 1000);
+            }});
+        
+        // 每个计时单位是一次完整的存档和读档：序列化、临时文件 + fsync + 重命名、读回、重新加载关卡并应用
+        const std::string saveFile = (directory / "savegame.dat").string();
+        auto buffer = std::make_shared<std::vector<unsigned char>>();
+        auto snapshot = std::make_shared<SaveSnapshot>();
+        auto loaded = std::make_shared<SaveSnapshot>();
+        scenarios.push_back({"save_restore_1000", "save and restore a level 3 game 1,000 times", 1000, 0.0f,
+            [](Game& game, PlayState& play) {
+                if (!play.startLevel(2)) return false;
+                keepBalls(play, 5);
+                for (int i = 0; i < 120; ++i) {
+                    game.simulate(tickSeconds); // 先打掉一些砖块，位图不是全 1
+                    keepBalls(play, 5);
+                }
+                return true;
+            },
+            [saveFile, buffer, snapshot, loaded](Game&, PlayState& play) {
+                play.fillSnapshot(*snapshot);
+                snapshot->serialize(*buffer);
+                SaveService::writeAtomically(saveFile, buffer->data(), buffer->size());
+                if (loaded->loadFromFile(saveFile)) {
+                    play.applySnapshot(*loaded);
+                }
+            }});
+        
+        return scenarios;
+    }
+    
+    // 进程的峰值常驻内存（MB）；Linux 上每个场景开始前清零，其他平台是整个进程的峰值
+    void resetPeakRss() {
+#ifdef __linux__
+        std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+    }
+    
+    double peakRssMb() {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return static_cast<double>(counters.PeakWorkingSetSize) / (1024.0 * 1024.0);
+        }
+        return 0.0;
+#else
+#ifdef __linux__
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.compare(0, 6, "VmHWM:") == 0) {
+                return std::atof(line.c_str() + 6) / 1024.0;
+            }
+        }
+#endif
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+        return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0); // 字节
+#else
+        return static_cast<double>(usage.ru_maxrss) / 1024.0;            // KB
+#endif
+#endif
+    }
+    
+    double percentile(std::vector<double>& sorted, double fraction) {
+        if (sorted.empty()) return 0.0;
+        std::size_t index = static_cast<std::size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+    
+    Report run(Game& game, const Scenario& scenario, std::uint64_t seed, bool& ok) {
+        Report report;
+        report.name = scenario.name;
+        report.ticks = scenario.ticks;
+        
+        resetPeakRss();
+        Utils::Random::setState(seed);
+        
+        // 与 --autopilot 相同：在 init 之前打开自动挡板，新开一局，不读写玩家的存档
+        auto state = std::make_unique<PlayState>(&game);
+        PlayState& play = *state;
+        play.setAutoPlay(true);
+        game.pushState(std::move(state));
+        ok = scenario.setup(game, play);
+        if (!ok) {
+            game.popState();
+            return report;
+        }
+        
+        // 计时循环中只写预先分配好的数组
+        std::vector<double> frameMs(static_cast<std::size_t>(scenario.ticks));
+        AllocTracker::endFrame();
+        
+        auto start = std::chrono::steady_clock::now();
+        auto previous = start;
+        for (int i = 0; i < scenario.ticks; ++i) {
+            scenario.tick(game, play);
+            auto now = std::chrono::steady_clock::now();
+            frameMs[static_cast<std::size_t>(i)] = std::chrono::duration<double, std::milli>(now - previous).count();
+            previous = now;
+        }
+        report.wallSeconds = std::chrono::duration<double>(previous - start).count();
+        
+        AllocTracker::endFrame();
+        report.allocationsCounted = AllocTracker::isAvailable();
+        report.allocations = AllocTracker::getLastFrame().total.allocations;
+        report.allocatedBytes = AllocTracker::getLastFrame().total.bytes;
+        report.allocationsPerTick = static_cast<double>(report.allocations) / scenario.ticks;
+        report.peakRssMb = peakRssMb();
+        
+        std::sort(frameMs.begin(), frameMs.end());
+        report.p50 = percentile(frameMs, 0.50);
+        report.p90 = percentile(frameMs, 0.90);
+        report.p99 = percentile(frameMs, 0.99);
+        report.max = frameMs.empty() ? 0.0 : frameMs.back();
+        report.simulatedSeconds = static_cast<double>(scenario.ticks) * scenario.simulatedSecondsPerTick;
+        report.ticksPerSecond = report.wallSeconds > 0.0 ? scenario.ticks / report.wallSeconds : 0.0;
+        
+        report.score = play.getScore();
+        report.bricksDestroyed = play.getStats().bricksDestroyed;
+        report.ballsLost = play.getStats().ballsLost;
+        report.levelsCleared = play.getStats().levelsCleared;
+        game.popState();
+        return report;
+    }
+    
+    // 阈值文件：每行 "场景.指标 = 数值"，# 开头为注释
+    bool loadThresholds(const std::string& filename, std::map<std::string, double>& thresholds) {
+        std::ifstream file(filename);
+        if (!file) {
+            return false;
+        }
+        std::string line;
+        while (std::getline(file, line)) {
+            std::string::size_type equals = line.find('=');
+            if (line.empty() || line[0] == '#' || equals == std::string::npos) {
+                continue;
+            }
+            std::string key = line.substr(0, equals);
+            key.erase(key.find_last_not_of(" \t\r") + 1);
+            key.erase(0, key.find_first_not_of(" \t"));
+            thresholds[key] = std::atof(line.c_str() + equals + 1);
+        }
+        return true;
+    }
+    
+    // 阈值中 max_ 开头的是上限，min_ 开头的是下限
+    void check(Report& report, const std::map<std::string, double>& thresholds) {
+        struct Metric {
+            const char* name;
+            double value;
+            bool available;
+        };
+        const Metric metrics[] = {
+            {"max_p50_ms", report.p50, true},
+            {"max_p99_ms", report.p99, true},
+            {"max_frame_ms", report.max, true},
+            {"min_ticks_per_second", report.ticksPerSecond, true},
+            {"max_peak_rss_mb", report.peakRssMb, true},
+            {"max_allocations_per_tick", report.allocationsPerTick, report.allocationsCounted},
+        };
+        for (const Metric& metric : metrics) {
+            auto it = thresholds.find(report.name + "." + metric.name);
+            if (it == thresholds.end() || !metric.available) {
+                continue;
+            }
+            const bool isMinimum = metric.name[1] == 'i';
+            const bool passed = isMinimum ? metric.value >= it->second : metric.value <= it->second;
+            report.checks.push_back({metric.name, it->second, metric.value, passed});
+            report.passed = report.passed && passed;
+        }
+    }
+    
+    void writeJson(std::ostream& out, const std::vector<Report>& reports, const Options& options, bool passed) {
+        char date[64];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+        
+        char number[64];
+        auto fixed = [&number](double value) {
+            std::snprintf(number, sizeof(number), "%.4f", value);
+            return number;
+        };
+        
+        out << "{\n";
+        out << "  \"context\": {\"date\": \"" << date << "\", \"seed\": " << options.seed
+            << ", \"tick_seconds\": " << fixed(tickSeconds) << ", \"allocation_tracking\": "
+            << (AllocTracker::isAvailable() ? "true" : "false") << "},\n";
+        out << "  \"scenarios\": [\n";
+        for (std::size_t i = 0; i < reports.size(); ++i) {
+            const Report& report = reports[i];
+            out << "    {\n";
+            out << "      \"name\": \"" << report.name << "\",\n";
+            out << "      \"ticks\": " << report.ticks << ",\n";
+            out << "      \"simulated_seconds\": " << fixed(report.simulatedSeconds) << ",\n";
+            out << "      \"wall_seconds\": " << fixed(report.wallSeconds) << ",\n";
+            out << "      \"ticks_per_second\": " << fixed(report.ticksPerSecond) << ",\n";
+            out << "      \"frame_ms\": {\"p50\": " << fixed(report.p50);
+            out << ", \"p90\": " << fixed(report.p90);
+            out << ", \"p99\": " << fixed(report.p99);
+            out << ", \"max\": " << fixed(report.max) << "},\n";
+            out << "      \"peak_rss_mb\": " << fixed(report.peakRssMb) << ",\n";
+            if (report.allocationsCounted) {
+                out << "      \"allocations\": " << report.allocations << ",\n";
+                out << "      \"allocated_bytes\": " << report.allocatedBytes << ",\n";
+                out << "      \"allocations_per_tick\": " << fixed(report.allocationsPerTick) << ",\n";
+            }
+            out << "      \"score\": " << report.score << ",\n";
+            out << "      \"bricks_destroyed\": " << report.bricksDestroyed << ",\n";
+            out << "      \"balls_lost\": " << report.ballsLost << ",\n";
+            out << "      \"levels_cleared\": " << report.levelsCleared << ",\n";
+            out << "      \"checks\": [";
+            for (std::size_t c = 0; c < report.checks.size(); ++c) {
+                const Report::Check& check = report.checks[c];
+                out << (c > 0 ? ", " : "") << "{\"metric\": \"" << check.metric << "\", \"limit\": " << fixed(check.limit);
+                out << ", \"value\": " << fixed(check.value) << ", \"passed\": " << (check.passed ? "true" : "false") << "}";
+            }
+            out << "],\n";
+            out << "      \"passed\": " << (report.passed ? "true" : "false") << "\n";
+            out << "    }" << (i + 1 < reports.size() ? "," : "") << "\n";
+        }
+        out << "  ],\n";
+        out << "  \"passed\": " << (passed ? "true" : "false") << "\n";
+        out << "}\n";
+    }
+    
+    bool parseOptions(int argc, char* argv[], Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--scenario" && hasValue) {
+                options.filter = argv[++i];
+            } else if (arg == "--thresholds" && hasValue) {
+                options.thresholdsFile = argv[++i];
+            } else if (arg == "--json" && hasValue) {
+                options.jsonFile = argv[++i];
+            } else if (arg == "--seed" && hasValue) {
+                options.seed = std::strtoull(argv[++i], nullptr, 10);
+            } else if (arg == "--list") {
+                options.list = true;
+            } else {
+                std::cerr << "Usage: " << argv[0]
+                          << " [--scenario text] [--thresholds file] [--json file|-] [--seed n] [--list]" << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 2;
+    }
+    
+    AllocTracker::TagScope tag(AllocTracker::General);
+    // 无窗口运行不加载字体、纹理和音效，缺少资源的警告不输出
+    Logger::getInstance()->setLevel(Logger::Error);
+    
+    Game game;
+    game.initHeadless(windowSize);
+    
+    const fs::path directory = fs::temp_directory_path() / "brickbreaker-scenarios";
+    std::error_code error;
+    fs::create_directories(directory, error);
+    const std::vector<Scenario> scenarios = makeScenarios(directory);
+    
+    if (options.list) {
+        for (const Scenario& scenario : scenarios) {
+            std::cout << scenario.name << ": " << scenario.description << std::endl;
+        }
+        return 0;
+    }
+    
+    std::map<std::string, double> thresholds;
+    if (!loadThresholds(options.thresholdsFile, thresholds)) {
+        std::cerr << "Cannot read thresholds file: " << options.thresholdsFile << std::endl;
+        return 2;
+    }
+    
+    // JSON 写到标准输出时表格改到标准错误
+    const bool jsonToStdout = options.jsonFile == "-";
+    std::ostream& table = jsonToStdout ? std::cerr : std::cout;
+    
+    std::vector<Report> reports;
+    bool passed = true;
+    for (const Scenario& scenario : scenarios) {
+        if (!options.filter.empty() && std::string(scenario.name).find(options.filter) == std::string::npos) {
+            continue;
+        }
+        
+        bool ok = false;
+        Report report = run(game, scenario, options.seed, ok);
+        if (!ok) {
+            std::cerr << scenario.name << ": setup failed (run from the build directory so resources/ is found)" << std::endl;
+            return 2;
+        }
+        check(report, thresholds);
+        passed = passed && report.passed;
+        
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-18s %6d ticks %10.0f ticks/s  p50 %8.3f  p99 %8.3f  max %8.3f ms  rss %7.1f MB",
+                      report.name.c_str(), report.ticks, report.ticksPerSecond, report.p50, report.p99, report.max,
+                      report.peakRssMb);
+        table << line;
+        if (report.allocationsCounted) {
+            std::snprintf(line, sizeof(line), "  alloc %.2f/tick", report.allocationsPerTick);
+            table << line;
+        }
+        table << (report.passed ? "  ok" : "  REGRESSION") << std::endl;
+        for (const Report::Check& check : report.checks) {
+            if (!check.passed) {
+                table << "    " << check.metric << ": " << check.value << " (limit " << check.limit << ")" << std::endl;
+            }
+        }
+        reports.push_back(std::move(report));
+    }
+    
+    if (!options.jsonFile.empty()) {
+        if (jsonToStdout) {
+            writeJson(std::cout, reports, options, passed);
+        } else {
+            std::ofstream file(options.jsonFile);
+            writeJson(file, reports, options, passed);
+            if (!file) {
+                std::cerr << "Cannot write " << options.jsonFile << std::endl;
+                return 2;
+            }
+        }
+    }
+    
+    fs::remove_all(directory, error);
+    return passed ? 0 : 1;
+}
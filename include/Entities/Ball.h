@@ -15,6 +15,7 @@ public:
     void reverseX();
     void reverseY();
     void setVelocity(const sf::Vector2f& vel);
+    void setSpeed(float newSpeed); // 运动中的球保持方向，按新速度运动
     sf::Vector2f getVelocity() const;
     void onCollision(Entity* other) override;
     
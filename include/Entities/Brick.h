@@ -8,6 +8,7 @@ private:
     int score;
     bool breakable;
     sf::Color color;
+    int index;      // 在关卡砖块列表中的下标（存档日志用），不在列表中时为 -1
     
     // Helper method to update color based on hit points
     void updateColorFromHitPoints();
@@ -28,6 +29,9 @@ public:
     bool isBreakable() const;
     void setBreakable(bool breakable);
     
+    int getIndex() const;
+    void setIndex(int index);
+    
     void hit();//handle hit
     
     void setColor(const sf::Color& color);
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "Entities/Brick.h"
+#include "Utils/LevelArena.h"
+
+// 一个关卡的砖块：砖块放在这个关卡自己的单调分配器里，
+// 列表析构、clear 或被新关卡替换时整块释放，不逐个调用析构函数
+// （Brick 的精灵就地存放，析构时没有需要释放的资源）；
+// 移动列表不改变砖块地址，可以在预取线程中构建后整个交给主线程
+class BrickList {
+private:
+    std::vector<Brick*> bricks;
+    std::unique_ptr<LevelArena> arena; // 放在 bricks 之后：被替换时先换掉指针数组，再释放旧的砖块
+
+public:
+    using iterator = std::vector<Brick*>::iterator;
+    using const_iterator = std::vector<Brick*>::const_iterator;
+    
+    BrickList() = default;
+    BrickList(BrickList&&) noexcept = default;
+    BrickList& operator=(BrickList&&) noexcept = default;
+    
+    // 预留 count 块砖的空间（分配器的第一块按这个大小分配）
+    void reserve(std::size_t count) {
+        bricks.reserve(bricks.size() + count);
+        if (!arena) {
+            arena = std::make_unique<LevelArena>(count > 0 ? count * sizeof(Brick) : sizeof(Brick) * 64);
+        }
+    }
+    
+    // 在关卡分配器中创建一块砖并加到列表末尾，砖块记下自己的下标
+    Brick* create(const sf::Vector2f& position, const sf::Vector2f& size, int hitPoints, int score) {
+        if (!arena) {
+            reserve(64);
+        }
+        Brick* brick = arena->create<Brick>(position, size, hitPoints, score);
+        brick->setIndex(static_cast<int>(bricks.size()));
+        bricks.push_back(brick);
+        return brick;
+    }
+    
+    // 一次释放所有砖块
+    void clear() {
+        bricks.clear();
+        arena.reset();
+    }
+    
+    std::size_t size() const { return bricks.size(); }
+    bool empty() const { return bricks.empty(); }
+    
+    Brick* operator[](std::size_t index) const { return bricks[index]; }
+    
+    iterator begin() { return bricks.begin(); }
+    iterator end() { return bricks.end(); }
+    const_iterator begin() const { return bricks.begin(); }
+    const_iterator end() const { return bricks.end(); }
+};
@@ -1,14 +1,13 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
-#include <memory>
+#include <optional>
 
 class Entity {
 protected:
     sf::Vector2f position;
     sf::Vector2f size;
-    sf::Texture texture;
-    std::unique_ptr<sf::Sprite> sprite; // 改为智能指针，以便后期初始化
+    std::optional<sf::Sprite> sprite; // 设置纹理时才创建，就地存放不单独分配
     bool active;
     float speed;
 
@@ -19,11 +18,15 @@ public:
 
     virtual void update(float deltaTime) = 0;
     virtual void render(sf::RenderWindow& window);
+    
+    // 附加变换后绘制（无尽模式按行平移时使用）
+    void renderTransformed(sf::RenderWindow& window, const sf::RenderStates& states);
 
     sf::FloatRect getBounds() const;
     sf::Vector2f getPosition() const;
     sf::Vector2f getSize() const;
     bool isActive() const;
+    float getSpeed() const;
 
     void setPosition(const sf::Vector2f& pos);
     void setSize(const sf::Vector2f& size);
@@ -22,11 +22,30 @@ private:
     std::unique_ptr<sf::Texture> splashTexture; //改为指针
     std::unique_ptr<sf::Sprite> splashSprite;
     
+    // 分配测试：自动游戏一段时间，稳态帧中有分配时以非零值退出
+    float allocationTestSeconds;
+    float allocationTestTimer;
+    int exitCode;
+    
+    // 自动挡板模式（--autopilot）：跳过菜单，挂机一直玩下去
+    bool autopilot;
+    
+    // 无窗口运行（基准程序）：状态按 headlessSize 布局，不处理事件、不渲染
+    bool headless;
+    sf::Vector2u headlessSize;
+    
     // 初始化资源
     void initResources();
     
     // 初始化启动页
     void initSplashScreen();
+    
+    // 开始分配测试 / 每帧检查测试是否结束
+    void startAllocationTest();
+    void updateAllocationTest();
+    
+    // 跳过启动页和菜单，开始新的一局并打开自动挡板
+    void startAutoPlay();
 
 public:
     Game();
@@ -35,9 +54,24 @@ public:
     // 初始化游戏
     void init();
     
+    // 无窗口初始化（代替 init）：不创建窗口、不加载资源、不读写 config.ini（使用默认配置）
+    void initHeadless(const sf::Vector2u& size);
+    
+    // 无窗口推进一帧：回收帧内存并更新当前状态，与 run 中的一帧相同但不处理事件、不渲染
+    void simulate(float deltaTime);
+    
     // 运行游戏
     void run();
     
+    // 分配测试模式（在 init 之前调用）
+    void setAllocationTest(float seconds);
+    
+    // 自动挡板模式（在 init 之前调用）
+    void setAutopilot(bool enabled);
+    
+    // 进程退出码（分配测试失败时非零）
+    int getExitCode() const;
+    
     // 处理事件
     void handleEvents();
     
@@ -65,6 +99,9 @@ public:
     // 获取窗口
     sf::RenderWindow& getWindow();
     
+    // 状态布局用的大小：窗口大小，无窗口运行时为 initHeadless 指定的大小
+    sf::Vector2u getSize() const;
+    
     // 获取FPS
     float getFPS() const;
     
@@ -18,7 +18,12 @@ public:
     virtual void update(float deltaTime) = 0;
     virtual void render(sf::RenderWindow& window) = 0;
     
-    // 状态切换事件：暂未使用
+    // 状态名（调试记录用）
+    virtual const char* getName() const = 0;
+    
+    // 状态切换事件，由 Game 在压栈、出栈和切换时调用：onEnter 在 init 之后，
+    // onExit 在状态被移除之前（PlayState 在这里写入存档日志并淡出音乐），
+    // onPause/onResume 在有新状态压在上面或重新回到栈顶时
     virtual void onEnter() {}
     virtual void onExit() {}
     virtual void onPause() {}
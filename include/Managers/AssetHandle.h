@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+// 资源ID：资源名的 FNV-1a 哈希，可在编译期计算
+struct AssetId {
+    std::uint32_t value;
+
+    constexpr explicit AssetId(std::string_view name) : value(hash(name)) {}
+
+    static constexpr std::uint32_t hash(std::string_view name) {
+        std::uint32_t h = 2166136261u;
+        for (char c : name) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    constexpr bool operator==(const AssetId& other) const { return value == other.value; }
+    constexpr bool operator!=(const AssetId& other) const { return value != other.value; }
+};
+
+// 编译期资源ID字面量，例如 "ball_windows"_asset
+constexpr AssetId operator""_asset(const char* name, std::size_t length) {
+    return AssetId(std::string_view(name, length));
+}
+
+// 类型化资源句柄：指向 AssetManager 内部稠密数组的下标
+template<typename Tag>
+struct AssetHandle {
+    static constexpr std::uint32_t Invalid = 0xFFFFFFFFu;
+
+    std::uint32_t index = Invalid;
+
+    constexpr bool isValid() const { return index != Invalid; }
+    constexpr bool operator==(const AssetHandle& other) const { return index == other.index; }
+    constexpr bool operator!=(const AssetHandle& other) const { return index != other.index; }
+};
+
+using TextureHandle = AssetHandle<struct TextureTag>;
+using FontHandle = AssetHandle<struct FontTag>;
+using SoundBufferHandle = AssetHandle<struct SoundBufferTag>;
+using SoundHandle = AssetHandle<struct SoundTag>;
+
+namespace std {
+    template<>
+    struct hash<AssetId> {
+        std::size_t operator()(const AssetId& id) const noexcept {
+            return id.value;
+        }
+    };
+}
@@ -2,48 +2,105 @@
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
+#include <cstdint>
+#include <deque>
 #include <string>
-#include <map>
+#include <unordered_map>
+#include "Managers/AssetHandle.h"
+#include "Managers/AssetPack.h"
+#include "Managers/SoundPool.h"
 
 class AssetManager {
 private:
     // 单例实例
     static AssetManager* s_instance;
-    
-    // 资源容器
-    std::map<std::string, sf::Texture> textures;
-    std::map<std::string, sf::Font> fonts;
-    std::map<std::string, sf::SoundBuffer> soundBuffers;
-    std::map<std::string, sf::Sound> sounds;
-    
+
+    // 已挂载的资源包（为空时从松散文件加载），需要比字体活得更久
+    AssetPack pack;
+
+    // 名字索引：仅在加载和解析句柄时使用，保存原名用于检测哈希冲突
+    struct IndexEntry {
+        std::uint32_t index;
+        std::string name;
+    };
+
+    // 资源容器：稠密存储，句柄即下标；deque 保证扩容时已有元素地址不变
+    std::deque<sf::Texture> textures;
+    std::deque<sf::Font> fonts;
+    std::deque<sf::SoundBuffer> soundBuffers;
+
+    // 音效通道池：SoundHandle 是池中音效定义的下标
+    SoundPool soundPool;
+
+    std::unordered_map<AssetId, IndexEntry> textureIndex;
+    std::unordered_map<AssetId, IndexEntry> fontIndex;
+    std::unordered_map<AssetId, IndexEntry> soundBufferIndex;
+    std::unordered_map<AssetId, IndexEntry> soundIndex;
+
     AssetManager();
 
+    // 把资源移动到槽位中，同名资源原地替换，返回下标（哈希冲突时返回Invalid）
+    template<typename T>
+    static std::uint32_t store(std::deque<T>& storage, std::unordered_map<AssetId, IndexEntry>& index,
+                               const std::string& name, T&& asset);
+
+    static std::uint32_t lookup(const std::unordered_map<AssetId, IndexEntry>& index, AssetId id);
+
 public:
     ~AssetManager();
-    
+
     // 获取单例实例
     static AssetManager* getInstance();
-    
+
     // 初始化资源
     void init();
-    
-    // 加载资源
-    void loadTexture(const std::string& name, const std::string& filename);
-    bool loadFont(const std::string& name, const std::string& filename);
-    void loadSoundBuffer(const std::string& name, const std::string& filename);
-    
+
+    // 挂载资源包，之后的加载优先从包内读取
+    bool mountPack(const std::string& filename);
+    void unmountPack();
+    bool hasPack() const;
+
+    // 在已挂载的资源包中查找文件（未挂载或未找到时返回空）
+    AssetBlob findPacked(const std::string& filename) const;
+
+    // 加载资源（失败时返回无效句柄）
+    TextureHandle loadTexture(const std::string& name, const std::string& filename);
+    FontHandle loadFont(const std::string& name, const std::string& filename);
+    SoundBufferHandle loadSoundBuffer(const std::string& name, const std::string& filename);
+
+    // 按ID解析句柄，应在初始化阶段调用并缓存结果
+    TextureHandle findTexture(AssetId id) const;
+    FontHandle findFont(AssetId id) const;
+    SoundBufferHandle findSoundBuffer(AssetId id) const;
+    SoundHandle findSound(AssetId id) const;
+
     // 检查资源是否存在
-    bool hasTexture(const std::string& name);
-    bool hasFont(const std::string& name);
-    
-    // 获取资源
+    bool hasTexture(AssetId id) const;
+    bool hasTexture(const std::string& name) const;
+    bool hasFont(AssetId id) const;
+    bool hasFont(const std::string& name) const;
+
+    // 通过句柄获取资源（O(1)，句柄必须有效）
+    sf::Texture& getTexture(TextureHandle handle);
+    sf::Font& getFont(FontHandle handle);
+    sf::SoundBuffer& getSoundBuffer(SoundBufferHandle handle);
+
+    // 通过名字获取资源（不存在时抛出异常）
     sf::Texture& getTexture(const std::string& name);
     sf::Font& getFont(const std::string& name);
     sf::SoundBuffer& getSoundBuffer(const std::string& name);
-    
-    // 创建音效
-    void createSound(const std::string& soundName, const std::string& bufferName);
-    
-    // 播放音效
+
+    // 创建音效：priority 越大越不容易被抢占，maxInstances 为同时发声上限
+    SoundHandle createSound(const std::string& soundName, const std::string& bufferName,
+                            int priority = 0, unsigned int maxInstances = 4);
+
+    // 设置音效音量（0-100）、开关和通道数
+    void configureSound(float volume, bool enabled, std::size_t voiceCount);
+
+    // 播放音效：只登记触发，实际播放在updateSounds中进行（热路径请使用句柄版本）
+    void playSound(SoundHandle handle) { soundPool.trigger(handle.index); }
     void playSound(const std::string& name);
-};
\ No newline at end of file
+
+    // 每帧调用一次，播放本帧触发的音效
+    void updateSounds();
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Utils/MappedFile.h"
+
+// 资源包文件格式：
+//   Header | Entry[entryCount]（按路径排序） | 数据块（每块按 BlobAlignment 对齐）
+namespace AssetPackFormat {
+    constexpr char Magic[4] = {'B', 'B', 'P', 'K'};
+    constexpr std::uint32_t Version = 1;
+    constexpr std::uint32_t BlobAlignment = 16;
+    constexpr std::size_t MaxPathLength = 112;
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t entryCount;
+        std::uint32_t indexOffset;
+    };
+
+    struct Entry {
+        char path[MaxPathLength]; // 以 '/' 分隔的相对路径，以 '\0' 结尾
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    static_assert(sizeof(Header) == 16, "AssetPack header must be 16 bytes");
+    static_assert(sizeof(Entry) == 128, "AssetPack entry must be 128 bytes");
+}
+
+// 包内资源的只读视图，指向映射内存，不拷贝
+struct AssetBlob {
+    const void* data = nullptr;
+    std::size_t size = 0;
+
+    explicit operator bool() const { return data != nullptr; }
+};
+
+class AssetPack {
+private:
+    MappedFile file;
+    const AssetPackFormat::Entry* entries;
+    std::uint32_t entryCount;
+
+public:
+    AssetPack();
+
+    // 映射并校验资源包
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const;
+
+    // 按路径查找资源（二分查找），未找到时返回空的AssetBlob
+    AssetBlob find(const std::string& path) const;
+
+    std::uint32_t getEntryCount() const;
+};
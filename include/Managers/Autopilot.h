@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Entities/Ball.h"
+#include "Entities/Paddle.h"
+
+// 自动挡板：代替键盘输入，用于无人值守的挂机测试和通关时间基准
+// 预测最低的那个下落球在挡板高度的落点（含左右墙反弹），把挡板移过去接球；
+// skill 决定瞄准误差（1 为总能接住），reactionDelay 是球改变方向后多久才按新的落点移动
+class Autopilot {
+private:
+    float windowWidth;
+    float skill;
+    float reactionDelay;
+    
+    // 正在跟踪的球和它上次的速度，速度变了（反弹）就重新预测
+    const Ball* trackedBall;
+    sf::Vector2f trackedVelocity;
+    float reactionTimer;
+    
+    // 挡板中心的目标位置；aimOffset 是本次接球的偏移（故意打斜一些，再加上技术误差）
+    float target;
+    bool hasTarget;
+    float aimOffset;
+    
+    // 当前关卡已经用了多久（模拟时间）
+    float levelTime;
+    
+    // 自己的随机数状态（SplitMix64）：不动游戏的 Utils::Random，打开自动挡板或改技术不会改变发球角度等随机序列
+    std::uint64_t rngState;
+    
+    // [min, max) 之间的随机数
+    float randomFloat(float min, float max);
+    
+    // 选出要接的球：最低的下落球，没有下落的球时取最低的球（已经掉到挡板以下的不算）
+    static const Ball* pickBall(const std::vector<std::unique_ptr<Ball>>& balls, float paddleTop);
+    
+    // 为新的一次接球选偏移
+    void chooseAim(float paddleWidth);
+
+public:
+    Autopilot(float windowWidth, float skill = 1.0f, float reactionDelay = 0.1f, std::uint64_t seed = 1);
+    
+    // skill 取 0-1，reactionDelay 单位为秒
+    void setSkill(float skill);
+    void setReactionDelay(float seconds);
+    
+    // 每帧调用一次（在挡板 update 之前），返回传给 Paddle::move 的方向；
+    // 和键盘一样每帧最多移动 getMaxSpeed() * deltaTime
+    float update(const std::vector<std::unique_ptr<Ball>>& balls, const Paddle& paddle, float deltaTime);
+    
+    // 换关、重开时调用：忘掉正在跟踪的球，关卡计时归零
+    void reset();
+    
+    // 本关到现在用了多久（模拟时间，秒）
+    float getLevelTime() const { return levelTime; }
+    
+    // 球底到达 paddleTop 时球心的横坐标，左右墙按镜面反射展开；球没有下落时返回当前球心
+    static float predictLanding(const sf::Vector2f& position, const sf::Vector2f& velocity, float radius,
+                                float paddleTop, float windowWidth);
+};
@@ -1,30 +1,48 @@
 #pragma once
 
 #include <vector>
+#include <cstdint>
 #include <memory>
 #include <functional>
 #include "Entities/Entity.h"
 #include "Entities/Ball.h"
-#include "Entities/Brick.h"
+#include "Entities/BrickList.h"
 #include "Entities/Paddle.h"
+#include "Managers/AssetHandle.h"
+#include "Managers/EndlessField.h"
+#include "Utils/FrameArena.h"
 
 class CollisionManager {
 private:
     // 游戏窗口尺寸
     sf::Vector2u windowSize;
     
+    // 球撞墙音效（构造时解析一次）
+    SoundHandle wallSound;
+    
     // 回调函数
-    std::function<void(Brick*)> onBrickHitCallback;
     std::function<void()> onBallPaddleCollisionCallback;
     
+    // 上一次 update 中的配对测试次数（性能统计用）
+    std::uint32_t pairTests;
+    
+    // 上一次 update 中被击碎的砖块（从每帧的分配器分配，只在本帧有效）
+    FrameArena::Vector<Brick*> destroyedBricks;
+    
+    // 每次 update 开始时调用：清空统计和上一帧的结果
+    void beginUpdate();
+    
     // 检测球与窗口边界的碰撞
     void checkBallWindowCollision(Ball* ball);
     
     // 检测两个实体之间的碰撞
     bool checkEntityCollision(Entity* a, Entity* b);
     
-    // 处理球与砖块的碰撞
-    void handleBallBrickCollision(Ball* ball, Brick* brick);
+    // 处理球与砖块的碰撞（offsetY 为砖块所在行的平移量，普通关卡为0）
+    void handleBallBrickCollision(Ball* ball, Brick* brick, float offsetY = 0.0f);
+    
+    // 检测球与无尽模式砖块场的碰撞，只检查与球竖直方向重叠的行
+    void checkBallFieldCollision(Ball* ball, EndlessField& field);
     
     // 处理球与挡板的碰撞
     void handleBallPaddleCollision(Ball* ball, Paddle* paddle);
@@ -37,15 +55,23 @@ public:
     void setWindowSize(const sf::Vector2u& size);
     
     // 设置回调函数
-    void setOnBrickHitCallback(std::function<void(Brick*)> callback);
     void setOnBallPaddleCollisionCallback(std::function<void()> callback);
     
     // 更新所有碰撞检测
-    void update(Ball* ball, Paddle* paddle, std::vector<std::unique_ptr<Brick>>& bricks);
+    void update(Ball* ball, Paddle* paddle, BrickList& bricks);
     
     // 更新多球碰撞检测
-    void update(std::vector<std::unique_ptr<Ball>>& balls, Paddle* paddle, std::vector<std::unique_ptr<Brick>>& bricks);
+    void update(std::vector<std::unique_ptr<Ball>>& balls, Paddle* paddle, BrickList& bricks);
+    
+    // 更新无尽模式的碰撞检测
+    void update(std::vector<std::unique_ptr<Ball>>& balls, Paddle* paddle, EndlessField& field);
     
     // 检测球是否掉落（游戏失败条件）
     bool isBallLost(const Ball* ball) const;
+    
+    // 上一次 update 中的配对测试次数
+    std::uint32_t getPairTests() const { return pairTests; }
+    
+    // 上一次 update 中被击碎的砖块，按击碎顺序；调用方在遍历完球之后再处理（可能会加球）
+    const FrameArena::Vector<Brick*>& getDestroyedBricks() const { return destroyedBricks; }
 };
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Entities/BrickList.h"
+#include "Managers/LevelGenerator.h"
+
+// 无尽模式的砖块场：固定数量的行组成环形缓冲区，新行从顶部生成，整个场缓慢下移
+// 所有砖块都按行内坐标创建（放在第0行的位置），下移只改变每行的偏移量，
+// 渲染和碰撞检测时再加上偏移，不需要每帧移动砖块；行数固定，运行多久内存和碰撞开销都不变
+class EndlessField {
+private:
+    struct Row {
+        std::uint64_t generation = 0;   // 第几行（递增），决定行内容和位置
+        int alive = 0;                  // 剩余砖块数，0表示空行（被清空或已回收）
+    };
+
+    BrickList bricks;        // slotCount * columns，按槽位排列
+    std::vector<Row> rows;
+    std::vector<LevelFormat::BrickRecord> rowRecords;  // 生成单行时复用的缓冲区
+    LevelGenerator::Params params;
+
+    int columns;
+    float baseY;          // 砖块创建时的y，即行内坐标的原点
+    float topY;           // 新行出现的位置
+    float dangerY;        // 还有砖块的行越过这里就算失守
+    float rowHeight;
+    float rowPitch;       // 行高加行间距
+    float scrollSpeed;    // 每秒下移的像素
+    float scroll;         // 最新一行已经下移的距离（0 到 rowPitch）
+    std::uint64_t nextGeneration;
+
+    // 在最旧的槽位上生成新的一行
+    void spawnRow();
+
+    // 清空一行（失守）
+    void clearRow(int slot);
+
+public:
+    EndlessField();
+
+    // 接管 LevelManager 创建好的砖块（slotCount * columns 块，位于 baseY 所在的行）
+    void init(BrickList rowBricks, int columns, float baseY,
+              float rowHeight, float rowPitch, float dangerY,
+              const LevelGenerator::Params& params, float scrollSpeed, int initialRows);
+
+    // 推进下移并生成新行，返回本帧失守的行数
+    int update(float deltaTime);
+
+    // 按行加上偏移绘制
+    void render(sf::RenderWindow& window);
+
+    // 行数据访问（碰撞检测用）
+    int getSlotCount() const;
+    int getColumns() const;
+    bool isRowEmpty(int slot) const;
+    float getRowTop(int slot) const;          // 世界坐标
+    float getRowOffset(int slot) const;       // 行内坐标到世界坐标的y偏移
+    float getRowHeight() const;
+    Brick* getBrick(int slot, int column) const;
+
+    // 砖块被打碎时由碰撞检测调用
+    void onBrickDestroyed(int slot);
+
+    // 当前剩余砖块总数
+    int getBrickCount() const;
+
+    bool isActive() const;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+// 编译后的二进制关卡格式（小端）：
+//   Header | BrickRecord[brickCount]
+// 由 LevelCompiler 从 resources/levels/levelN.txt 生成 levelN.bbl，文本格式（见 LevelParser.h）仍是源文件
+namespace LevelFormat {
+    constexpr char Magic[4] = {'B', 'B', 'L', 'V'};
+    constexpr std::uint32_t Version = 1;
+    constexpr const char* Extension = ".bbl";
+
+    // 行列号用16位存储
+    constexpr int MaxDimension = 0xFFFF;
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint16_t rows;
+        std::uint16_t columns;
+        std::uint32_t brickCount;
+        std::uint32_t recordOffset;
+        std::uint32_t reserved;
+    };
+
+    // 每块砖一条记录，按行优先顺序排列
+    struct BrickRecord {
+        std::uint16_t column;
+        std::uint16_t row;
+        std::uint8_t type;
+        std::uint8_t hitPoints;
+        std::uint16_t reserved;
+        std::uint32_t score;
+    };
+
+    static_assert(sizeof(Header) == 24, "Level header must be 24 bytes");
+    static_assert(sizeof(BrickRecord) == 12, "Brick record must be 12 bytes");
+
+    // levelN.txt -> levelN.bbl
+    inline std::string compiledPath(const std::string& sourcePath) {
+        std::string::size_type dot = sourcePath.find_last_of('.');
+        std::string::size_type slash = sourcePath.find_last_of("/\\");
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+            return sourcePath + Extension;
+        }
+        return sourcePath.substr(0, dot) + Extension;
+    }
+
+    // 写出一个 .bbl 文件（LevelCompiler 和基准程序共用），记录紧跟在头部之后
+    inline bool writeFile(const std::string& filename, int rows, int columns,
+                          const BrickRecord* records, std::size_t count) {
+        Header header{};
+        std::memcpy(header.magic, Magic, sizeof(Magic));
+        header.version = Version;
+        header.rows = static_cast<std::uint16_t>(rows);
+        header.columns = static_cast<std::uint16_t>(columns);
+        header.brickCount = static_cast<std::uint32_t>(count);
+        header.recordOffset = sizeof(Header);
+
+        std::ofstream output(filename, std::ios::binary | std::ios::trunc);
+        if (!output.is_open()) {
+            return false;
+        }
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        output.write(reinterpret_cast<const char*>(records), static_cast<std::streamsize>(count * sizeof(BrickRecord)));
+        return output.good();
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Managers/LevelFormat.h"
+
+// 按种子生成砖块布局，用于压力测试和长时间运行的基准关卡
+// 每个格子的随机数只由 (seed, 行, 列) 决定，与生成顺序和平台无关，同一种子总是得到同一关卡
+namespace LevelGenerator {
+    enum class Symmetry {
+        None,
+        Horizontal,   // 左右镜像
+        Vertical,     // 上下镜像
+        Both
+    };
+
+    struct Params {
+        std::uint64_t seed = 1;
+        int rows = 8;
+        int columns = 10;
+        float density = 0.8f;                          // 格子被填充的概率（0-1）
+        float hitPointWeights[3] = {0.6f, 0.3f, 0.1f}; // 耐久为1/2/3的权重
+        float typeWeights[4] = {0.0f, 1.0f, 1.0f, 1.0f}; // 类型0-3（颜色）的权重
+        Symmetry symmetry = Symmetry::None;
+        int scorePerHitPoint = 100;
+    };
+
+    // 行列上限由记录格式决定
+    constexpr int MaxDimension = LevelFormat::MaxDimension;
+
+    // SplitMix64：把格子编号混合成64位随机数
+    inline std::uint64_t mix(std::uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    // 取随机数中的21位映射到[0, 1)
+    inline float unitFloat(std::uint64_t bits, int shift) {
+        return static_cast<float>((bits >> shift) & 0x1FFFFF) / static_cast<float>(0x200000);
+    }
+
+    // 按权重选择下标，权重全为0时返回0
+    template<std::size_t N>
+    inline int pickWeighted(const float (&weights)[N], float u) {
+        float total = 0.0f;
+        for (float w : weights) total += std::max(w, 0.0f);
+        if (total <= 0.0f) return 0;
+
+        float target = u * total;
+        for (std::size_t i = 0; i < N; ++i) {
+            target -= std::max(weights[i], 0.0f);
+            if (target < 0.0f) return static_cast<int>(i);
+        }
+        return static_cast<int>(N - 1);
+    }
+
+    // 生成按行优先排列的砖块记录，行列数会被限制在格式上限内
+    inline void generate(const Params& params, std::vector<LevelFormat::BrickRecord>& records) {
+        const int rows = std::clamp(params.rows, 1, MaxDimension);
+        const int columns = std::clamp(params.columns, 1, MaxDimension);
+        const bool mirrorColumns = params.symmetry == Symmetry::Horizontal || params.symmetry == Symmetry::Both;
+        const bool mirrorRows = params.symmetry == Symmetry::Vertical || params.symmetry == Symmetry::Both;
+
+        records.clear();
+        records.reserve(static_cast<std::size_t>(static_cast<float>(rows) * columns * std::clamp(params.density, 0.0f, 1.0f)) + 1);
+
+        const std::uint64_t seedMix = mix(params.seed);
+        for (int row = 0; row < rows; ++row) {
+            const int sourceRow = mirrorRows ? std::min(row, rows - 1 - row) : row;
+            for (int col = 0; col < columns; ++col) {
+                const int sourceColumn = mirrorColumns ? std::min(col, columns - 1 - col) : col;
+
+                // 镜像格子使用源格子的随机数，保证对称
+                const std::uint64_t cell = static_cast<std::uint64_t>(sourceRow) * MaxDimension + sourceColumn;
+                const std::uint64_t bits = mix(seedMix ^ cell);
+
+                if (unitFloat(bits, 0) >= params.density) {
+                    continue;
+                }
+
+                LevelFormat::BrickRecord record;
+                record.column = static_cast<std::uint16_t>(col);
+                record.row = static_cast<std::uint16_t>(row);
+                record.hitPoints = static_cast<std::uint8_t>(pickWeighted(params.hitPointWeights, unitFloat(bits, 21)) + 1);
+                record.type = static_cast<std::uint8_t>(pickWeighted(params.typeWeights, unitFloat(bits, 42)));
+                record.reserved = 0;
+                record.score = static_cast<std::uint32_t>(params.scorePerHitPoint * record.hitPoints);
+                records.push_back(record);
+            }
+        }
+    }
+}
@@ -3,8 +3,12 @@
 #include <vector>
 #include <string>
 #include <memory>
-#include <fstream>
-#include "Entities/Brick.h"
+#include <atomic>
+#include <future>
+#include "Entities/BrickList.h"
+#include "Managers/LevelFormat.h"
+#include "Managers/LevelGenerator.h"
+#include "Managers/EndlessField.h"
 #include "Utils/Config.h"
 
 class LevelManager {
@@ -13,10 +17,6 @@ private:
     int currentLevel;
     int totalLevels;
     
-    // 关卡尺寸
-    int rows;
-    int columns;
-    
     // 砖块尺寸和间距
     sf::Vector2f brickSize;
     sf::Vector2f brickPadding;
@@ -24,26 +24,62 @@ private:
     // 关卡区域的位置和大小
     sf::Vector2f levelPosition;
     sf::Vector2f levelSize;
+    
+    // 后台预取：正在构建或已构建好的关卡（-1表示没有）
+    int prefetchedLevel;
+    std::atomic<bool> prefetchCancelled;
+    std::future<BrickList> prefetched; // 放在最后，析构时先等待工作线程
+    
+    // 按记录批量创建砖块（文本关卡、二进制关卡和生成关卡共用的构建路径）
+    // fitToArea 为true时缩小砖块高度和间距，使整个网格放进关卡区域
+    // cancel 非空时会定期检查，被置位后提前返回
+    void buildBricks(const LevelFormat::BrickRecord* records, std::size_t count, int gridColumns, int gridRows,
+                     BrickList& bricks, bool fitToArea = false,
+                     const std::atomic<bool>* cancel = nullptr) const;
+    
+    // 映射并解析文本关卡，解析错误会带上行号和列号
+    bool loadTextLevel(const std::string& filename, BrickList& bricks,
+                       const std::atomic<bool>* cancel = nullptr) const;
+    
+    // 映射并加载编译后的二进制关卡，文件不存在或无效时返回false
+    bool loadCompiledLevel(const std::string& filename, BrickList& bricks,
+                           const std::atomic<bool>* cancel = nullptr) const;
+    
+    // 读取并构建关卡，不修改管理器状态，可在工作线程中调用
+    BrickList buildLevel(int levelNumber, const std::atomic<bool>* cancel = nullptr) const;
 
 public:
     LevelManager();
+    ~LevelManager();
     
     // 初始化关卡管理器
     void init(const std::vector<std::string>& levelFiles, 
               const sf::Vector2f& levelPos, 
               const sf::Vector2f& levelSize);
     
-    // 加载指定关卡
-    std::vector<std::unique_ptr<Brick>> loadLevel(int levelNumber);
-    
-    // 加载指定关卡（返回bool表示成功与否）
-    bool loadLevel(int levelNumber, std::vector<std::unique_ptr<Brick>>& bricks);
+    // 加载指定关卡（从0开始，对应init传入的levelFiles）
+    BrickList loadLevel(int levelNumber);
     
     // 加载下一关卡
-    std::vector<std::unique_ptr<Brick>> loadNextLevel();
+    BrickList loadNextLevel();
+    
+    // 按种子和参数生成关卡（不改变当前关卡号），同一参数总是得到相同布局
+    BrickList generateLevel(const LevelGenerator::Params& params) const;
+    
+    // 为无尽模式创建环形缓冲区中的砖块，行数按关卡区域顶部到失守线的距离确定
+    void initEndless(EndlessField& field, std::uint64_t seed, float dangerY) const;
     
     // 重新加载当前关卡
-    std::vector<std::unique_ptr<Brick>> reloadCurrentLevel();
+    BrickList reloadCurrentLevel();
+    
+    // 在工作线程中预先构建指定关卡，之后的loadLevel直接取用结果
+    void prefetch(int levelNumber);
+    
+    // 放弃正在进行的预取
+    void cancelPrefetch();
+    
+    // 预取的关卡是否已构建完成
+    bool isPrefetchReady() const;
     
     // 获取当前关卡号
     int getCurrentLevel() const;
@@ -57,7 +93,4 @@ public:
     // 设置砖块尺寸和间距
     void setBrickSize(const sf::Vector2f& size);
     void setBrickPadding(const sf::Vector2f& padding);
-    
-    // 从文件加载关卡数据
-    std::vector<std::unique_ptr<Brick>> loadLevelFromFile(const std::string& filename);
 };
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Managers/LevelFormat.h"
+
+// 文本关卡解析器（游戏和 LevelCompiler 共用）
+//
+// 格式：
+//   # 以 '#' 开头的行是注释
+//   size 6 10          可选头部，必须出现在第一行网格之前，用于预先分配存储
+//   2222222222         每个字符是一个格子
+//
+// 格子字符：' ' '.' '0' '\t' 为空；'1'-'3' 为对应耐久的砖块；'x' 'X' 为普通砖块；其它字符报错
+// 没有头部时行数为最后一个非空行，列数为最长的行
+namespace LevelParser {
+    struct Error {
+        int line = 0;      // 从1开始
+        int column = 0;    // 从1开始
+        std::string message;
+    };
+
+    struct Layout {
+        int rows = 0;
+        int columns = 0;
+        std::vector<LevelFormat::BrickRecord> records;  // 按行优先排列
+    };
+
+    // 一次扫描整个缓冲区，失败时填写 error 并返回false
+    bool parse(const char* data, std::size_t size, Layout& layout, Error& error);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include "Managers/MusicStream.h"
+
+// 背景音乐播放器：两个流式音轨交替使用，实现不阻塞主循环的淡入淡出
+class MusicPlayer {
+private:
+    // 单例实例
+    static MusicPlayer* s_instance;
+
+    struct Deck {
+        MusicStream stream;
+        float volume = 0.0f;      // 当前音量（0-1，乘以主音量）
+        float fadeRate = 0.0f;    // 每秒音量变化量，负数表示淡出
+        bool active = false;
+    };
+
+    std::array<Deck, 2> decks;
+    int current;                  // 当前（淡入或正在播放的）音轨下标，-1表示无
+
+    float musicVolume;            // 主音量（0-100）
+    bool enabled;
+    unsigned int bufferMilliseconds;
+    std::size_t bufferChunks;
+
+    MusicPlayer();
+
+    void applyVolume(Deck& deck);
+
+public:
+    ~MusicPlayer();
+
+    // 获取单例实例
+    static MusicPlayer* getInstance();
+
+    // 从配置读取音量和缓冲区大小
+    void configure(float volume, bool enabled, unsigned int bufferMilliseconds, std::size_t bufferChunks);
+
+    // 切换曲目，fadeSeconds 内完成交叉淡入淡出；同一曲目正在播放时不做任何事
+    bool play(const std::string& filename, float fadeSeconds = 1.0f);
+
+    // 淡出并停止
+    void stop(float fadeSeconds = 1.0f);
+
+    // 每帧调用，推进淡入淡出
+    void update(float deltaTime);
+
+    void setVolume(float volume);
+    bool isPlaying() const;
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <SFML/Audio.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 流式背景音乐：边播放边从磁盘（或资源包映射内存）解码。
+// 解码缓冲区是固定大小的环形块队列，驻留内存只与块大小有关，与曲目长度无关。
+class MusicStream : public sf::SoundStream {
+private:
+    sf::InputSoundFile file;
+    std::string filename;
+
+    // 环形解码缓冲：chunkCount 个块，每块 chunkSamples 个采样
+    std::vector<std::int16_t> ring;
+    std::size_t chunkSamples;
+    std::size_t chunkCount;
+    std::size_t nextChunk;
+
+protected:
+    // 在SFML的音频线程中调用
+    bool onGetData(Chunk& data) override;
+    void onSeek(sf::Time timeOffset) override;
+
+public:
+    MusicStream();
+
+    // 打开曲目：只读取文件头，不解码音频数据
+    // bufferMilliseconds 为每个解码块的时长，chunkCount 为环形队列的块数
+    bool open(const std::string& filename, unsigned int bufferMilliseconds, std::size_t chunkCount);
+
+    const std::string& getFilename() const;
+
+    // 解码缓冲区占用的字节数
+    std::size_t getBufferBytes() const;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 自动存档日志（小端，只追加）：
+//   Header | { BatchHeader | Record[count] } ...
+// 每批记录带校验和，写到一半断电时只丢最后一批；Header 中的代数必须和 save.dat 一致才回放
+namespace JournalFormat {
+    constexpr char Magic[4] = {'B', 'B', 'J', 'L'};
+    constexpr std::uint32_t Version = 1;
+
+    enum RecordType : std::uint8_t {
+        BrickDestroyed = 1,   // value: 砖块下标
+        ScoreDelta = 2,       // value: 分数增量
+        LifeLost = 3,         // value: 剩余生命
+        LevelChange = 4       // value: 新关卡（0开始）
+    };
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t generation;
+    };
+
+    struct BatchHeader {
+        std::uint32_t count;
+        std::uint32_t checksum;     // FNV-1a，覆盖本批全部记录
+    };
+
+    struct Record {
+        std::uint8_t type;
+        std::uint8_t reserved[3];
+        std::int32_t value;
+    };
+
+    static_assert(sizeof(Header) == 16, "Journal header must be 16 bytes");
+    static_assert(sizeof(BatchHeader) == 8, "Journal batch header must be 8 bytes");
+    static_assert(sizeof(Record) == 8, "Journal record must be 8 bytes");
+}
+
+// 两次整存之间的增量：主线程攒一小批，定时交给 SaveService 追加写入
+class SaveJournal {
+private:
+    std::string filename;
+    std::vector<JournalFormat::Record> batch;
+    std::vector<unsigned char> bytes;   // 组批缓冲区，反复复用
+    float interval;
+    float elapsed;
+
+public:
+    SaveJournal();
+
+    void setFile(const std::string& file);
+    void setInterval(float seconds);
+
+    // 记录一条增量（只进内存）
+    void record(JournalFormat::RecordType type, std::int32_t value);
+
+    // 距上次写入超过间隔时把攒下的记录写出去
+    void update(float deltaTime);
+
+    // 立即写出攒下的记录
+    void flush();
+
+    // 整存之后调用：丢弃未写的记录，日志文件重写为只有头部，代数与新存档相同
+    void reset(std::uint64_t generation);
+
+    // 读出与给定代数匹配的全部有效记录，遇到损坏的批次即停止
+    static bool load(const std::string& file, std::uint64_t generation,
+                     std::vector<JournalFormat::Record>& records);
+};
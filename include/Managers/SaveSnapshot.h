@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 二进制存档格式（小端）：
+//   Header | Body | brick位图(uint64 × ceil(brickCount/64)) | BallRecord[ballCount]
+// 校验和覆盖 Header 之后的全部内容，与 config.ini 完全分开
+namespace SaveFormat {
+    constexpr char Magic[4] = {'B', 'B', 'S', 'V'};
+    constexpr std::uint32_t Version = 2;
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t payloadSize;
+        std::uint32_t checksum;     // FNV-1a
+    };
+
+    struct Body {
+        std::int32_t score;
+        std::int32_t lives;
+        std::int32_t level;
+        std::uint32_t flags;        // bit0: 球已发射
+        float paddleX;
+        float paddleY;
+        std::uint64_t rngState;
+        std::uint32_t brickCount;
+        std::uint32_t ballCount;
+        std::uint64_t generation;   // 每次整存加一，日志只回放同一代的记录
+    };
+
+    struct BallRecord {
+        float x;
+        float y;
+        float vx;
+        float vy;
+    };
+
+    static_assert(sizeof(Header) == 16, "Save header must be 16 bytes");
+    static_assert(sizeof(Body) == 48, "Save body must be 48 bytes");
+    static_assert(sizeof(BallRecord) == 16, "Ball record must be 16 bytes");
+}
+
+// 一局游戏的完整状态，砖块和球的数量没有上限
+class SaveSnapshot {
+private:
+    std::vector<std::uint64_t> brickBits;
+
+public:
+    std::int32_t score = 0;
+    std::int32_t lives = 0;
+    std::int32_t level = 0;
+    bool ballLaunched = false;
+    float paddleX = 0.0f;
+    float paddleY = 0.0f;
+    std::uint64_t rngState = 0;
+    std::uint64_t generation = 0;
+    std::uint32_t brickCount = 0;
+    std::vector<SaveFormat::BallRecord> balls;
+
+    // 砖块状态位图
+    void setBrickCount(std::uint32_t count);
+    void setBrickActive(std::uint32_t index, bool active);
+    bool isBrickActive(std::uint32_t index) const;
+
+    // 序列化到缓冲区（复用缓冲区的容量）
+    void serialize(std::vector<unsigned char>& out) const;
+
+    // 从缓冲区解析，版本或校验和不对时返回false
+    bool deserialize(const unsigned char* data, std::size_t size);
+
+    bool loadFromFile(const std::string& filename);
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <SFML/Audio.hpp>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// 复音音效池：固定数量的发声通道（voice），按优先级分配，满时抢占旧通道。
+// trigger() 只记录一个标志位，同一帧内重复触发的音效在 flush() 时合并为一次播放。
+class SoundPool {
+private:
+    // 音效定义
+    struct SoundDef {
+        const sf::SoundBuffer* buffer;
+        int priority;
+        unsigned int maxInstances;
+    };
+
+    // 发声通道，sf::Sound 需要缓冲区才能构造，因此首次使用时才创建
+    struct Voice {
+        std::optional<sf::Sound> sound;
+        std::uint32_t def = 0;
+        int priority = 0;
+        std::uint64_t startSerial = 0;
+    };
+
+    std::vector<SoundDef> defs;
+    std::vector<Voice> voices;
+
+    // 本帧待播放的音效（标志位用于去重）
+    std::vector<std::uint8_t> pendingFlags;
+    std::vector<std::uint32_t> pending;
+
+    std::uint64_t serial;
+    float volume;
+    bool enabled;
+
+    static bool isBusy(const Voice& voice);
+
+    // 为音效选择一个通道，没有可用通道时返回nullptr
+    Voice* acquireVoice(std::uint32_t def);
+
+public:
+    explicit SoundPool(std::size_t voiceCount = 16);
+
+    // 调整通道数量（会停止所有正在播放的音效）
+    void setVoiceCount(std::size_t voiceCount);
+
+    // 注册音效，返回音效下标
+    std::uint32_t addSound(const sf::SoundBuffer& buffer, int priority, unsigned int maxInstances);
+
+    // 替换已注册音效的定义
+    void redefineSound(std::uint32_t index, const sf::SoundBuffer& buffer, int priority, unsigned int maxInstances);
+
+    // 触发音效（仅置标志位，真正播放在flush中进行）
+    void trigger(std::uint32_t index) {
+        if (index < pendingFlags.size() && !pendingFlags[index]) {
+            pendingFlags[index] = 1;
+            pending.push_back(index);
+        }
+    }
+
+    // 每帧调用一次：为本帧触发的音效分配通道并播放
+    void flush();
+
+    // 停止所有通道
+    void stopAll();
+
+    // 音量（0-100）与开关
+    void setVolume(float volume);
+    void setEnabled(bool enabled);
+};
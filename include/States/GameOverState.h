@@ -69,6 +69,7 @@ public:
     void handleInput(const sf::Event& event) override;
     void update(float deltaTime) override;
     void render(sf::RenderWindow& window) override;
+    const char* getName() const override { return "GameOver"; }
     
     // 菜单操作
     void moveUp();
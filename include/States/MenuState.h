@@ -55,6 +55,7 @@ public:
     void handleInput(const sf::Event& event) override; // 修改为常量引用
     void update(float deltaTime) override;
     void render(sf::RenderWindow& window) override;
+    const char* getName() const override { return "Menu"; }
     
     // 菜单操作
     void moveUp();
@@ -3,26 +3,45 @@
 #include "GameState.h"
 #include "Entities/Ball.h"
 #include "Entities/Paddle.h"
-#include "Entities/Brick.h"
+#include "Entities/BrickList.h"
 #include "Managers/CollisionManager.h"
 #include "Managers/LevelManager.h"
+#include "Managers/Autopilot.h"
+#include "Managers/AssetHandle.h"
+#include "Managers/SaveSnapshot.h"
+#include "Managers/SaveJournal.h"
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <optional>
 
 class Game;
 
 class PlayState : public GameState {
+public:
+    // 本局的统计（挂机测试和场景基准报告用）
+    struct Stats {
+        std::uint64_t bricksDestroyed = 0;
+        std::uint64_t ballsLost = 0;
+        std::uint64_t levelsCleared = 0;
+    };
+
 private:
     // 游戏实体
     std::vector<std::unique_ptr<Ball>> balls;  // 支持多球
+    std::vector<std::unique_ptr<Ball>> spareBalls; // 回收的球，生成新球时复用
     std::unique_ptr<Paddle> paddle;
-    std::vector<std::unique_ptr<Brick>> bricks;
+    BrickList bricks;
     
     // 管理器
     CollisionManager collisionManager;
     LevelManager levelManager;
     
+    // 无尽模式：砖块在环形缓冲区中，不使用 bricks
+    bool endlessMode;
+    EndlessField endlessField;
+    
     // 游戏状态
     int score;
     int lives;
@@ -30,22 +49,46 @@ private:
     bool gameOver;
     bool levelCompleted;
     bool justGameOver; // 标记游戏是否刚刚结束
+    Stats stats;
     
     // 奖励机制相关
     bool multiballEnabled;
     int maxBalls;
     int ballSpawnChance;
     
+    // 自动存档：整存之间的增量写入日志，代数用来匹配存档和日志
+    SaveJournal journal;
+    std::uint64_t saveGeneration;
+    
+    // 配置热重载的订阅编号
+    std::vector<int> settingSubscriptions;
+    
     // 挡板移动控制
     bool paddleMovingLeft;
     bool paddleMovingRight;
     
+    // 自动挡板：代替键盘输入，自动发球、过关后继续、游戏结束后重开（挂机测试和分配测试用）
+    std::optional<Autopilot> autopilot;
+    
+    // 资源句柄（init中解析一次，热路径直接使用）
+    TextureHandle ballTexture;
+    TextureHandle paddleTexture;
+    TextureHandle backgroundTexture;
+    SoundHandle breakSound;
+    SoundHandle hitSound;
+    
     // UI元素
     sf::Font font;
     std::unique_ptr<sf::Text> scoreText;   // 使用指针避免默认构造函数
     std::unique_ptr<sf::Text> livesText;   // 使用指针避免默认构造函数
     std::unique_ptr<sf::Text> messageText1; // 使用指针避免默认构造函数
     std::unique_ptr<sf::Text> messageText2; // 使用指针避免默认构造函数
+    
+    // HUD 上显示的数值和文字（数值变化时才重建，复用字符串容量）
+    int shownScore;
+    int shownLives;
+    sf::String scoreString;
+    sf::String livesString;
 
     // 初始化游戏
     void initGame();
@@ -56,6 +99,9 @@ private:
     // 检查游戏状态
     void checkGameStatus();
     
+    // 砖块被击碎：加分、音效、记入存档日志
+    void onBrickDestroyed(Brick* brick);
+    
     // 更新UI
     void updateUI();
     
@@ -65,26 +111,44 @@ private:
     // 加载下一关
     void loadNextLevel();
     
+    // 播放关卡背景音乐
+    void playLevelMusic(int levelNumber);
+    
+    // 开始无尽模式
+    void startEndless();
+    
+    // 显示游戏结束信息
+    void showGameOver();
+    
     // 重新开始游戏
     void restartGame();
     
+    // 换上已经加载好的砖块后开始这一关：球和挡板复位，自动挡板重新计时
+    bool enterLevel();
+    
     // 奖励机制相关方法
     void loadRewardSettings();
+    void subscribeSettings();
     void trySpawnNewBall();
     Ball* createNewBall(const sf::Vector2f& position, const sf::Vector2f& velocity);
+    void releaseAllBalls();
+    void reserveBalls();
     
     // 存档相关方法
     bool loadGameState();
+    void replayJournal(const std::vector<JournalFormat::Record>& records);
 
 public:
-    PlayState(Game* game);
-    virtual ~PlayState() = default;
+    PlayState(Game* game, bool endless = false);
+    virtual ~PlayState();
     
     // 重写GameState的虚函数
     void init() override;
     void handleInput(const sf::Event& event) override;
     void update(float deltaTime) override;
     void render(sf::RenderWindow& window) override;
+    const char* getName() const override { return "Play"; }
+    void onExit() override;
     
     // 游戏控制
     void launchBall();
@@ -93,13 +157,31 @@ public:
     // 启动新的一局
     void startNewGame();
     
+    // 打开或关闭自动挡板（技术和反应时间来自配置）；在 init 之前打开时直接开始新的一局，不加载存档
+    void setAutoPlay(bool enabled);
+    
+    // 跳到指定关卡或生成的关卡（场景基准用），关卡为空时返回false
+    bool startLevel(int levelNumber);
+    bool startGeneratedLevel(const LevelGenerator::Params& params);
+    
+    // 从挡板上方再发出一个球（发球速度，随机角度），优先复用备用的球
+    void addBall();
+    
     // 获取游戏状态
     int getScore() const;
     int getLives() const;
     bool isGameOver() const;
     bool isLevelCompleted() const;
+    std::size_t getBallCount() const;
+    const Stats& getStats() const;
 
     // 添加分数
     void addScore(int points);
-    void saveGameState() const;
+    
+    // 整存（同时清空日志）
+    void saveGameState();
+    
+    // 存档内容与局面之间的转换（整存、读档和场景基准共用）
+    void fillSnapshot(SaveSnapshot& snapshot) const;
+    void applySnapshot(const SaveSnapshot& snapshot);
 };
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// 内存分配统计：定义了 BRICKBREAKER_ALLOC_TRACKING 时替换全局 operator new，
+// 按当前线程的标签统计分配次数和字节数，主循环每帧取一次差值；
+// 守卫模式下，稳态帧（PlayState 正常游戏中）出现游戏逻辑的分配就记一次违规
+class AllocTracker {
+public:
+    enum Tag : std::uint8_t {
+        General,    // 主线程中没有更具体标签的代码
+        Play,       // PlayState 更新
+        Collision,  // 碰撞检测
+        UI,         // HUD 文字
+        Save,       // 存档和日志（有意的写盘，不算违规）
+        Debug,      // 叠加层、追踪、卡顿记录（不算违规）
+        Other,      // 其他线程（音频、存档线程、预取等）
+        TagCount
+    };
+    
+    struct Counts {
+        std::uint64_t allocations;
+        std::uint64_t bytes;
+    };
+    
+    struct FrameStats {
+        Counts total;
+        Counts tags[TagCount];
+    };
+    
+    // 作用域标签：构造时切换当前线程的标签，析构时恢复
+    class TagScope {
+    private:
+        Tag previous;
+    
+    public:
+        explicit TagScope(Tag tag);
+        ~TagScope();
+        
+        TagScope(const TagScope&) = delete;
+        TagScope& operator=(const TagScope&) = delete;
+    };
+
+private:
+    // 全部是静态成员：operator new 里不能再分配单例
+    static std::atomic<std::uint64_t> allocationCounts[TagCount];
+    static std::atomic<std::uint64_t> byteCounts[TagCount];
+    static thread_local Tag currentTag;
+    
+    static FrameStats lastFrame;
+    static Counts frameStart[TagCount];
+    
+    // 守卫模式
+    static bool guardEnabled;
+    static int warmupFrames;
+    static bool steadyFrame;
+    static std::uint64_t violations;
+
+public:
+    // 编译时是否打开了分配统计
+    static bool isAvailable();
+    
+    // operator new 调用
+    static void onAllocate(std::size_t size) {
+        allocationCounts[currentTag].fetch_add(1, std::memory_order_relaxed);
+        byteCounts[currentTag].fetch_add(size, std::memory_order_relaxed);
+    }
+    
+    static Tag getTag() { return currentTag; }
+    
+    // 主循环每帧结束时调用：计算本帧的分配并检查守卫
+    static void endFrame();
+    static const FrameStats& getLastFrame() { return lastFrame; }
+    
+    // 守卫：跳过前 warmup 个稳态帧（字形缓存、容器容量在这期间长到位）
+    static void setGuard(bool enabled, int warmup);
+    static void markSteadyFrame() { steadyFrame = true; }
+    static std::uint64_t getViolations() { return violations; }
+    
+    // 守卫检查的标签（游戏逻辑）
+    static bool isGuarded(Tag tag) { return tag <= UI; }
+    
+    static const char* tagName(Tag tag);
+};
+
+inline AllocTracker::TagScope::TagScope(Tag tag) : previous(currentTag) {
+    currentTag = tag;
+}
+
+inline AllocTracker::TagScope::~TagScope() {
+    currentTag = previous;
+}
@@ -1,22 +1,40 @@
 #pragma once
 
+#include "Utils/GameSettings.h"
+#include "Utils/Logger.h"
 #include <SFML/Graphics.hpp>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <map>
 #include <any>
-#include <fstream>
-#include <sstream>
+#include <functional>
+#include <vector>
 #include <memory>
-#include <typeindex>
-#include <iostream>
 
 class Config {
 private:
     // 单例实例
     static std::unique_ptr<Config> instance;
     
-    // 配置数据存储
-    std::unordered_map<std::string, std::any> values;
+    // 配置表中的项直接存放在这里（主线程的热路径只读这里）
+    GameSettings settings;
+    
+    // 发布给其他线程的只读快照：settings 每次变化后整体换成新的一份（atomic_load / atomic_store）
+    std::shared_ptr<const GameSettings> snapshot;
+    
+    // 配置表之外的项（例如 file.music_levelN），按键名排序
+    using ExtraMap = std::map<std::string, std::any, std::less<>>;
+    ExtraMap extras;
+    
+    // 配置项变化时的回调（只在主线程调用）
+    struct Subscriber {
+        int id;
+        std::string_view key;
+        std::function<void()> notify;
+    };
+    std::vector<Subscriber> subscribers;
+    int nextSubscriberId;
+    int notifyDepth;    // 大于0时正在通知，取消订阅只做标记，通知完再删除
     
     // 默认配置文件路径
     std::string configFilePath;
@@ -30,19 +48,29 @@ private:
     // 保存配置到文件
     bool saveToFile(const std::string& filename) const;
     
-    // 解析配置行
-    void parseLine(const std::string& line);
+    // 解析整个缓冲区：一次遍历，按行切出 string_view，不做逐行分配
+    // extras 为空时只解析配置表中的项（后台线程重新加载时使用）
+    static void parseBuffer(const char* data, std::size_t size, GameSettings& target, ExtraMap* extraTarget);
     
-    // 将配置值写入文件的辅助函数
-    void writeConfigValue(std::ofstream& file, const std::string& key, const std::any& value) const;
+    // 解析一项：配置表中的键按声明的类型解析，其余按分区规则或值的形式推断
+    static void parseEntry(std::string_view key, std::string_view value, GameSettings& target, ExtraMap* extraTarget);
     
-    // 将值字符串转换为具体类型
-    template<typename T>
-    T convertValue(const std::string& valueStr);
+    // 把 settings 拷贝成新的快照发布出去（settings 每次修改之后调用）
+    void publish();
+    
+    // 通知订阅了该键的回调
+    void notify(std::string_view key);
     
-    // 特化的转换函数
-    sf::Vector2f convertVector2f(const std::string& valueStr);
-    sf::Color convertColor(const std::string& valueStr);
+    // 按键名排序（即按分区）一次写出全部配置
+    void writeConfig(std::ostream& file) const;
+    
+    // 读写一项的通用形式，配置表中的键转发到 settings
+    std::any getAny(std::string_view key) const;
+    void setAny(std::string_view key, const std::any& value);
+    
+    // 从 any 中取值，允许整数和浮点数互转，不抛异常
+    template<typename T>
+    static bool readAny(const std::any& value, T& out);
 
 public:
     // 获取单例实例
@@ -61,7 +89,34 @@ public:
     // 保存配置
     bool save(const std::string& filename = "") const;
     
-    // 获取配置值
+    // 在主线程生成文本，交给 SaveService 在后台写盘
+    void saveAsync(const std::string& filename = "") const;
+    
+    // 解析后的配置，只在主线程读；引用在 Config 的生命周期内一直有效
+    const GameSettings& getSettings() const;
+    
+    // 当前配置的只读快照，任意线程都可以调用，拿到的内容不会再被修改
+    std::shared_ptr<const GameSettings> getSnapshot() const;
+    
+    // 通过类型化句柄读写配置表中的项
+    template<typename T>
+    const T& get(SettingHandle<T> handle) const;
+    
+    template<typename T>
+    void set(SettingHandle<T> handle, const T& value);
+    
+    // 订阅配置项的变化（setValue 或热重载），返回的编号用于取消订阅
+    template<typename T>
+    int subscribe(SettingHandle<T> handle, std::function<void(const typename SettingHandle<T>::ValueType&)> callback);
+    void unsubscribe(int id);
+    
+    // 整体替换配置表中的项，只通知值真正变化了的键（主线程调用）
+    void applySettings(const GameSettings& next);
+    
+    // 只解析配置表中的项，不修改 Config 本身，可以在任意线程调用
+    static bool parseSettingsFile(const std::string& filename, GameSettings& target);
+    
+    // 获取配置值（按字符串查表，不在配置表中的键使用）
     template<typename T>
     T getValue(const std::string& key, const T& defaultValue) const;
     
@@ -72,7 +127,7 @@ public:
     // 检查配置是否存在
     bool hasValue(const std::string& key) const;
     
-    // 删除配置
+    // 删除配置（配置表中的项恢复默认值）
     void removeValue(const std::string& key);
     
     // 清空所有配置
@@ -80,57 +135,70 @@ public:
     
     // 设置配置文件路径
     void setConfigFilePath(const std::string& path);
+    const std::string& getConfigFilePath() const;
 };
 
 // 模板函数的实现
+template<typename T>
+bool Config::readAny(const std::any& value, T& out) {
+    if (const T* exact = std::any_cast<T>(&value)) {
+        out = *exact;
+        return true;
+    }
+    
+    // 特殊处理浮点数和整数的转换
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, int>) {
+        if (const int* i = std::any_cast<int>(&value)) {
+            out = static_cast<T>(*i);
+            return true;
+        }
+        if (const float* f = std::any_cast<float>(&value)) {
+            out = static_cast<T>(*f);
+            return true;
+        }
+        if (const double* d = std::any_cast<double>(&value)) {
+            out = static_cast<T>(*d);
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename T>
+const T& Config::get(SettingHandle<T> handle) const {
+    return settings.*handle.slot;
+}
+
+template<typename T>
+void Config::set(SettingHandle<T> handle, const T& value) {
+    settings.*handle.slot = value;
+    publish();
+    notify(handle.key);
+}
+
+template<typename T>
+int Config::subscribe(SettingHandle<T> handle, std::function<void(const typename SettingHandle<T>::ValueType&)> callback) {
+    const int id = nextSubscriberId++;
+    subscribers.push_back({id, handle.key, [this, handle, callback = std::move(callback)]() {
+        callback(settings.*handle.slot);
+    }});
+    return id;
+}
+
 template<typename T>
 T Config::getValue(const std::string& key, const T& defaultValue) const {
-    auto it = values.find(key);
-    if (it != values.end()) {
-        try {
-            return std::any_cast<T>(it->second);
-        } catch (const std::bad_any_cast&) {
-            std::cerr << "Config: Type conversion error, key: " << key << std::endl;
-            
-            // 特殊处理浮点数和整数的转换
-            if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
-                try {
-                    // 尝试从整数转换
-                    if (it->second.type() == typeid(int)) {
-                        return static_cast<T>(std::any_cast<int>(it->second));
-                    }
-                } catch (...) {
-                    // 忽略转换错误
-                }
-            }
-            else if constexpr (std::is_same_v<T, int>) {
-                try {
-                    // 尝试从浮点数转换
-                    if (it->second.type() == typeid(float)) {
-                        return static_cast<T>(std::any_cast<float>(it->second));
-                    }
-                    else if (it->second.type() == typeid(double)) {
-                        return static_cast<T>(std::any_cast<double>(it->second));
-                    }
-                } catch (...) {
-                    // 忽略转换错误
-                }
-            }
-            
-            return defaultValue;
+    std::any value = getAny(key);
+    if (value.has_value()) {
+        T result;
+        if (readAny(value, result)) {
+            return result;
         }
+        LOG_WARN(Config, "Type conversion error, key: %s", key.c_str());
     }
     return defaultValue;
 }
 
 template<typename T>
 void Config::setValue(const std::string& key, const T& value) {
-    values[key] = value;
+    setAny(key, std::any(value));
 }
-
-// 特化的模板函数声明
-template<>
-sf::Vector2f Config::convertValue<sf::Vector2f>(const std::string& valueStr);
-
-template<>
-sf::Color Config::convertValue<sf::Color>(const std::string& valueStr);
\ No newline at end of file
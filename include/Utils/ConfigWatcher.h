@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Utils/GameSettings.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+// 配置热重载：后台线程监视配置文件（Linux 上用 inotify，其他平台轮询修改时间），
+// 文件变化后解析出一份新的 GameSettings，以不可变快照的形式原子地发布；
+// 主线程每帧调用 applyPending()，在下一次更新时把快照交给 Config 并触发订阅回调
+class ConfigWatcher {
+private:
+    // 单例实例
+    static ConfigWatcher* s_instance;
+    
+    std::string filename;
+    std::shared_ptr<const GameSettings> base;     // 上次解析的结果，只在工作线程使用
+    std::shared_ptr<const GameSettings> pending;  // 只通过 std::atomic_* 访问
+    std::atomic<bool> hasPending;                 // 没有新快照时主线程只读这个标志
+    std::atomic<bool> stopping;
+    std::thread worker;
+    
+    ConfigWatcher();
+    
+    void run();
+    void reload();
+
+public:
+    ~ConfigWatcher();
+    
+    // 获取单例实例
+    static ConfigWatcher* getInstance();
+    
+    // 开始监视；以当前配置为基础，文件中缺少的项保持不变
+    void start(const std::string& file, const GameSettings& current);
+    
+    // 停止监视线程
+    void stop();
+    
+    // 主线程调用：有新快照时应用到 Config，返回是否应用了
+    bool applyPending();
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Utils/FrameProfiler.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 卡顿记录器：在内存中滚动保存最近几秒的帧记录（分阶段耗时、实体数量、状态栈）和事件（输入、碰撞），
+// 某一帧超过预算时把整个窗口交给存档服务在后台写成带时间戳的文件；
+// 平时每帧只是拷贝一条定长记录，不分配内存
+class FlightRecorder {
+public:
+    enum EventType : std::uint8_t {
+        KeyPressed,     // a = 键码
+        KeyReleased,    // a = 键码
+        MouseButton,    // a = 按钮，b = x
+        BallPaddle,     // a = 球的 x
+        BallBrick,      // a = 砖块剩余血量
+        BallWall,       // a = 球的 x，b = 球的 y
+        BallLost,       // a = 剩余球数
+        EventTypeCount
+    };
+    
+    struct Event {
+        std::uint64_t frame;
+        std::int32_t a;
+        std::int32_t b;
+        EventType type;
+    };
+    
+    static constexpr std::size_t MaxStates = 6;
+    
+    struct FrameRecord {
+        std::uint64_t frame;
+        double time;                               // 秒，从 configure() 开始
+        FrameProfiler::FrameSample sample;
+        std::array<const char*, MaxStates> states; // 从栈底到栈顶，字符串字面量
+        std::uint8_t stateDepth;
+    };
+    
+    static constexpr std::size_t FrameCapacity = 1024;  // 2的幂
+    static constexpr std::size_t EventCapacity = 2048;  // 2的幂
+
+private:
+    // 单例实例
+    static FlightRecorder* s_instance;
+    
+    bool enabled;
+    float budgetMs;
+    float windowSeconds;
+    std::chrono::steady_clock::time_point startTime;
+    double lastDumpTime;
+    
+    // 环形缓冲区，只在主线程读写
+    std::array<FrameRecord, FrameCapacity> frames;
+    std::uint64_t frameCount;
+    std::array<Event, EventCapacity> events;
+    std::uint64_t eventCount;
+    
+    std::array<const char*, MaxStates> stateStack;
+    std::size_t stateDepth;
+    
+    FlightRecorder();
+    
+    void dump(const FrameRecord& spike);
+
+public:
+    // 获取单例实例
+    static FlightRecorder* getInstance();
+    
+    // 帧耗时超过 budget 毫秒时写出最近 seconds 秒的记录；budget <= 0 时关闭
+    void configure(float budget, float seconds);
+    bool isEnabled() const { return enabled; }
+    
+    // 记录一个事件（关闭时直接返回）
+    void record(EventType type, int a = 0, int b = 0) {
+        if (!enabled) return;
+        events[eventCount & (EventCapacity - 1)] = {frameCount, a, b, type};
+        ++eventCount;
+    }
+    
+    // 跟随 Game 的状态栈
+    void pushState(const char* name);
+    void popState();
+    
+    // 主循环在 FrameProfiler::endFrame 之后调用
+    void endFrame();
+    
+    static const char* eventName(EventType type);
+};
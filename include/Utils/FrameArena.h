@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+// 每帧的线性分配器：主循环每次迭代开始时 reset()，只把指针移回开头（O(1)），
+// 一帧内的临时容器（碰撞结果、叠加层文字等）从这里分配，不经过 operator new；
+// 只在主线程使用，分配到的内存只在当前帧有效，不能跨帧保存
+class FrameArena : public std::pmr::memory_resource {
+public:
+    // 从本帧内存分配的容器
+    template<typename T>
+    using Vector = std::pmr::vector<T>;
+    using String = std::pmr::string;
+    
+    static constexpr std::size_t DefaultCapacity = 64 * 1024;
+
+private:
+    // 单例实例
+    static FrameArena* s_instance;
+    
+    // 超出容量时从上游分配的块，挂成单链表，reset 时释放
+    struct Overflow {
+        Overflow* next;
+        std::byte* chunk;
+        std::size_t size;
+        std::size_t alignment;
+    };
+    
+    std::unique_ptr<std::byte[]> block;
+    std::size_t capacity;
+    std::size_t used;
+    Overflow* overflow;
+    std::size_t overflowBytes;
+    
+    // 统计（以帧为单位，在 reset 时结算）
+    std::size_t lastFrameBytes;
+    std::size_t peakBytes;
+    std::uint64_t totalBytes;
+    std::uint64_t frames;
+    std::uint64_t overflowFrames;
+    
+    explicit FrameArena(std::size_t capacity);
+    
+    void releaseOverflow();
+    
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void*, std::size_t, std::size_t) override {} // 单个释放什么都不做，reset 时整体回收
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+public:
+    ~FrameArena() override;
+    
+    // 获取单例实例
+    static FrameArena* getInstance();
+    
+    // 开始新的一帧：结算上一帧的用量，之前分配的内存全部失效；
+    // 上一帧溢出过时把主块扩大到能装下峰值，之后的帧不再溢出
+    void reset();
+    
+    std::size_t getCapacity() const { return capacity; }
+    std::size_t getUsed() const { return used + overflowBytes; }
+    std::size_t getLastFrameBytes() const { return lastFrameBytes; }
+    std::size_t getPeakBytes() const { return peakBytes; }
+    std::size_t getAverageBytes() const { return frames > 0 ? static_cast<std::size_t>(totalBytes / frames) : 0; }
+    std::uint64_t getOverflowFrames() const { return overflowFrames; }
+};
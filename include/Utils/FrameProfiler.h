@@ -0,0 +1,120 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// 分阶段的帧耗时统计
+// 主线程每帧写一条记录到无锁环形缓冲区（单写者），叠加层从最近的记录计算分位数；
+// 叠加层可见或有人需要数据（例如卡顿记录器）时才统计，关闭时每个计时点只有一次分支判断
+class FrameProfiler {
+public:
+    enum Phase {
+        Events,      // handleEvents
+        Entities,    // 实体更新
+        Collision,   // 碰撞检测
+        Status,      // 游戏状态检查
+        Render,      // 绘制
+        Display,     // window.display（包括等待垂直同步）
+        PhaseCount
+    };
+    
+    struct FrameSample {
+        float phaseMs[PhaseCount];
+        float frameMs;
+        std::uint32_t drawCalls;
+        std::uint32_t balls;
+        std::uint32_t bricks;
+        std::uint32_t pairTests;    // 碰撞检测中的配对测试次数
+    };
+    
+    static constexpr std::size_t Capacity = 256; // 2的幂
+    
+    // 作用域计时：构造时开始，析构时计入当前帧
+    class Scope {
+    private:
+        Phase phase;
+        bool active;
+        std::chrono::steady_clock::time_point start;
+    
+    public:
+        explicit Scope(Phase phase);
+        ~Scope();
+        
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+private:
+    // 单例实例
+    static FrameProfiler* s_instance;
+    
+    bool enabled;           // 正在统计
+    bool overlayVisible;
+    bool recording;         // 不显示叠加层也统计
+    FrameSample current;
+    std::chrono::steady_clock::time_point frameStart;
+    
+    // 环形缓冲区：head 是已写入的总帧数，读者只读 head 之前的记录
+    std::array<FrameSample, Capacity> ring;
+    std::atomic<std::uint64_t> head;
+    
+    // 叠加层（每隔一段时间才重新生成文字）
+    std::unique_ptr<sf::Text> overlayText;
+    float overlayTimer;
+    
+    FrameProfiler();
+    
+    void updateEnabled();
+    void rebuildOverlay();
+
+public:
+    // 获取单例实例
+    static FrameProfiler* getInstance();
+    
+    // 叠加层开关
+    void setOverlayVisible(bool value);
+    void toggleOverlay();
+    
+    // 不显示叠加层时也统计
+    void setRecording(bool value);
+    
+    bool isEnabled() const { return enabled; }
+    
+    // 主循环每帧调用
+    void beginFrame();
+    void endFrame();
+    
+    void addPhaseTime(Phase phase, float milliseconds);
+    
+    // 计数（关闭时直接返回）
+    void countDrawCall() { if (enabled) ++current.drawCalls; }
+    void addPairTests(std::uint32_t count) { if (enabled) current.pairTests += count; }
+    void setEntityCounts(std::uint32_t balls, std::uint32_t bricks);
+    
+    // 复制最近的至多 maxCount 帧（从旧到新），返回复制的帧数；可以在其他线程调用
+    std::size_t copyRecent(FrameSample* out, std::size_t maxCount) const;
+    
+    // 在窗口左上角绘制统计叠加层
+    void renderOverlay(sf::RenderWindow& window, float deltaTime);
+};
+
+inline FrameProfiler::Scope::Scope(Phase phase)
+    : phase(phase),
+      active(FrameProfiler::getInstance()->isEnabled()) {
+    if (active) {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+inline FrameProfiler::Scope::~Scope() {
+    if (active) {
+        std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        FrameProfiler::getInstance()->addPhaseTime(phase, elapsed.count());
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <string>
+
+// 配置表：每一项只在这里声明一次 —— 类型、GameSettings 中的字段、ini 键、默认值
+// Config 在加载和 setValue 时把值解析进 GameSettings，热路径直接读字段，不再查表和 any_cast
+#define BRICKBREAKER_SETTINGS(X) \
+    /* 窗口设置 */ \
+    X(std::string, windowTitle,           "window.title",               std::string("BrickBreaker")) \
+    X(int,         windowWidth,           "window.width",               800) \
+    X(int,         windowHeight,          "window.height",              600) \
+    X(bool,        windowFullscreen,      "window.fullscreen",          false) \
+    X(bool,        windowVsync,           "window.vsync",               true) \
+    X(int,         framerateLimit,        "window.framerate_limit",     60) \
+    /* 游戏设置 */ \
+    X(float,       ballSpeed,             "game.ball_speed",            300.0f) \
+    X(float,       paddleSpeed,           "game.paddle_speed",          50.0f) \
+    X(int,         initialLives,          "game.initial_lives",         10) \
+    X(int,         autosaveIntervalMs,    "game.autosave_interval_ms",  250) \
+    /* 奖励机制设置 */ \
+    X(int,         maxBalls,              "reward.max_balls",           3) \
+    X(int,         ballSpawnChance,       "reward.ball_spawn_chance",   30) \
+    /* 无尽模式设置（density 为百分比，seed 为0表示每局随机） */ \
+    X(int,         endlessColumns,        "endless.columns",            10) \
+    X(int,         endlessDensity,        "endless.density",            60) \
+    X(float,       endlessScrollSpeed,    "endless.scroll_speed",       8.0f) \
+    X(int,         endlessStartRows,      "endless.start_rows",         4) \
+    X(int,         endlessSeed,           "endless.seed",               0) \
+    /* 颜色设置 */ \
+    X(sf::Color,   backgroundColor,       "colors.background",          sf::Color(20, 20, 50)) \
+    X(sf::Color,   ballColor,             "colors.ball",                sf::Color::White) \
+    X(sf::Color,   paddleColor,           "colors.paddle",              sf::Color::White) \
+    X(sf::Color,   brickColor1,           "colors.brick1",              sf::Color::Red) \
+    X(sf::Color,   brickColor2,           "colors.brick2",              sf::Color::Yellow) \
+    X(sf::Color,   brickColor3,           "colors.brick3",              sf::Color::Green) \
+    X(sf::Color,   brickColor4,           "colors.brick4",              sf::Color::Blue) \
+    X(sf::Color,   brickColor5,           "colors.brick5",              sf::Color(128, 0, 128)) \
+    /* 音效设置 */ \
+    X(bool,        soundEnabled,          "sound.enabled",              true) \
+    X(float,       soundVolume,           "sound.volume",               100.0f) \
+    X(float,       musicVolume,           "sound.music_volume",         80.0f) \
+    X(int,         soundVoices,           "sound.voices",               16) \
+    X(int,         musicBufferMs,         "sound.music_buffer_ms",      250) \
+    X(int,         musicBufferChunks,     "sound.music_buffer_chunks",  3) \
+    X(float,       musicFade,             "sound.music_fade",           1.5f) \
+    /* 控制设置 - 使用SFML 3.0.0的枚举值 */ \
+    X(int,         keyMoveLeft,           "controls.move_left",         static_cast<int>(sf::Keyboard::Key::Left)) \
+    X(int,         keyMoveRight,          "controls.move_right",        static_cast<int>(sf::Keyboard::Key::Right)) \
+    X(int,         keyLaunch,             "controls.launch",            static_cast<int>(sf::Keyboard::Key::Space)) \
+    X(int,         keyPause,              "controls.pause",             static_cast<int>(sf::Keyboard::Key::P)) \
+    /* 调试 */ \
+    X(bool,        frameProfiler,         "debug.frame_profiler",       false) \
+    X(std::string, traceFile,             "debug.trace_file",           std::string()) \
+    X(float,       frameBudgetMs,         "debug.frame_budget_ms",      50.0f) \
+    X(float,       flightRecorderSeconds, "debug.flight_recorder_seconds", 5.0f) \
+    X(std::string, logLevel,              "debug.log_level",            std::string("info")) \
+    X(std::string, logFile,               "debug.log_file",             std::string()) \
+    X(int,         logRateLimit,          "debug.log_rate_limit",       10) \
+    /* 自动挡板（--autopilot）的技术和反应时间（秒）；simulation_speed 为每帧的模拟步数，大于1时快进 */ \
+    X(float,       autopilotSkill,        "debug.autopilot_skill",      1.0f) \
+    X(float,       autopilotReaction,     "debug.autopilot_reaction",   0.1f) \
+    X(int,         simulationSpeed,       "debug.simulation_speed",     1) \
+    /* 文件 */ \
+    X(std::string, assetPackFile,         "file.asset_pack",            std::string("resources.pak")) \
+    X(std::string, saveFile,              "file.save",                  std::string("save.dat")) \
+    X(std::string, saveJournalFile,       "file.save_journal",          std::string("save.journal"))
+
+// 解析后的配置，每个字段都有默认值
+struct GameSettings {
+#define BRICKBREAKER_SETTING_FIELD(type, member, key, value) type member = value;
+    BRICKBREAKER_SETTINGS(BRICKBREAKER_SETTING_FIELD)
+#undef BRICKBREAKER_SETTING_FIELD
+};
+
+// 带类型的配置句柄：键名和字段在编译期绑定，读取就是一次成员访问
+template<typename T>
+struct SettingHandle {
+    using ValueType = T;
+    T GameSettings::* slot;
+    const char* key;
+};
+
+namespace Settings {
+#define BRICKBREAKER_SETTING_HANDLE(type, member, key, value) \
+    constexpr SettingHandle<type> member{&GameSettings::member, key};
+    BRICKBREAKER_SETTINGS(BRICKBREAKER_SETTING_HANDLE)
+#undef BRICKBREAKER_SETTING_HANDLE
+}
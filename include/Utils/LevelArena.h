@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+// 关卡生命周期的单调分配器：只活到关卡结束的对象从几个大块中顺序分配，
+// 换关时整个分配器一次释放，不再逐个析构和释放；
+// 对象的析构函数不会被调用，只能放析构时没有其他资源要释放的对象
+class LevelArena {
+private:
+    std::pmr::monotonic_buffer_resource resource;
+    std::size_t objectCount;
+
+public:
+    // initialSize 是第一块的大小，用完后按倍数增长
+    explicit LevelArena(std::size_t initialSize)
+        : resource(initialSize), objectCount(0) {
+    }
+    
+    LevelArena(const LevelArena&) = delete;
+    LevelArena& operator=(const LevelArena&) = delete;
+    
+    // 在分配器中构造一个对象
+    template<typename T, typename... Args>
+    T* create(Args&&... args) {
+        void* memory = resource.allocate(sizeof(T), alignof(T));
+        ++objectCount;
+        return new (memory) T(std::forward<Args>(args)...);
+    }
+    
+    // 给关卡内的其他容器使用（std::pmr）
+    std::pmr::memory_resource* getResource() { return &resource; }
+    
+    std::size_t getObjectCount() const { return objectCount; }
+    
+    // 一次释放所有对象，之前返回的指针全部失效
+    void release() {
+        resource.release();
+        objectCount = 0;
+    }
+};
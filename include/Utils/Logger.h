@@ -0,0 +1,202 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// 编译时去掉低于这个级别的日志：0 trace，1 debug，2 info，3 warning，4 error
+// Debug 构建保留全部，其他构建默认从 info 开始
+#ifndef BRICKBREAKER_LOG_MIN_LEVEL
+#ifdef DEBUG
+#define BRICKBREAKER_LOG_MIN_LEVEL 0
+#else
+#define BRICKBREAKER_LOG_MIN_LEVEL 2
+#endif
+#endif
+
+// 异步日志：调用线程只把格式化好的消息放进定长槽位的无锁队列（多写者单读者），
+// 后台线程负责写到控制台和日志文件，慢的串口控制台不会卡住主循环；
+// 队列满时丢弃并计数，不阻塞也不分配内存；同一个调用点每秒最多输出若干条，多出的只计数
+class Logger {
+public:
+    enum Level : std::uint8_t {
+        Trace,
+        Debug,
+        Info,
+        Warning,
+        Error,
+        LevelCount
+    };
+    
+    enum Category : std::uint8_t {
+        Core,       // 主循环、窗口、状态切换
+        Assets,     // 纹理、字体、资源包
+        Audio,      // 音效和音乐
+        Levels,     // 关卡加载和生成
+        Save,       // 存档和日志
+        Config,     // 配置文件
+        Diag,       // 追踪、卡顿记录等诊断工具
+        CategoryCount
+    };
+    
+    // 调用点的频率限制状态（LOG_* 宏中的静态变量）
+    struct CallSite {
+        std::atomic<std::int64_t> windowStart{-1000000};  // 毫秒，相对于日志开始
+        std::atomic<std::uint32_t> count{0};
+        std::atomic<std::uint32_t> suppressed{0};
+    };
+    
+    static constexpr std::size_t MessageSize = 232;
+    static constexpr std::size_t QueueCapacity = 1024; // 2的幂
+
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> sequence;  // 等于写入位置时可写，等于位置+1时可读
+        double time;                          // 秒
+        std::uint32_t thread;
+        std::uint32_t suppressed;             // 这条消息之前被限流丢掉的条数
+        Level level;
+        Category category;
+        char text[MessageSize];
+    };
+    
+    // 单例实例
+    static Logger* s_instance;
+    static std::atomic<std::uint32_t> nextThreadId;
+    static thread_local std::uint32_t t_threadId;
+    
+    std::atomic<std::uint8_t> minLevel;
+    std::atomic<std::uint32_t> rateLimit;     // 每个调用点每秒的条数，0 表示不限
+    std::chrono::steady_clock::time_point origin;
+    
+    // 队列：生产者竞争 tail，只有写线程读 head
+    std::unique_ptr<Slot[]> slots;
+    alignas(64) std::atomic<std::uint64_t> tail;
+    alignas(64) std::uint64_t head;
+    std::atomic<std::uint64_t> dropped;
+    std::uint64_t droppedReported;
+    
+    // 写线程（第一条日志时启动）
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping;
+    std::atomic<bool> started;
+    std::atomic<bool> stopped;                // shutdown 之后改为同步输出
+    std::thread writer;
+    
+    // 日志文件，只在持有 fileMutex 时访问
+    std::mutex fileMutex;
+    std::FILE* file;
+    
+    Logger();
+    
+    bool admit(CallSite& site, std::uint32_t& suppressed);
+    Slot* claim(std::uint64_t& position);
+    void publish(Slot* slot, std::uint64_t position, Level level, Category category, std::uint32_t suppressed);
+    void writeNow(Level level, Category category, std::uint32_t suppressed, const char* text);
+    void startWriter();
+    void run();
+    void drain();
+    void emit(double time, std::uint32_t thread, Level level, Category category, std::uint32_t suppressed, const char* text);
+    double seconds() const;
+    
+    template<typename... Args>
+    static void format(char* out, const char* format, Args... args) {
+        if constexpr (sizeof...(Args) == 0) {
+            std::strncpy(out, format, MessageSize - 1);
+            out[MessageSize - 1] = '\0';
+        } else {
+            std::snprintf(out, MessageSize, format, args...);
+        }
+    }
+
+public:
+    ~Logger();
+    
+    // 获取单例实例
+    static Logger* getInstance();
+    
+    // 运行时级别
+    void setLevel(Level level) { minLevel.store(level, std::memory_order_relaxed); }
+    bool isEnabled(Level level) const { return level >= minLevel.load(std::memory_order_relaxed); }
+    
+    // 每个调用点每秒最多输出的条数，0 表示不限
+    void setRateLimit(int perSecond) { rateLimit.store(perSecond > 0 ? perSecond : 0, std::memory_order_relaxed); }
+    
+    // 同时写到文件（追加），空字符串表示只写控制台；失败返回 false
+    bool setFile(const std::string& filename);
+    
+    // 写一条日志（printf 格式，消息过长时截断）；字符串参数需要传 c_str()
+    template<typename... Args>
+    void write(CallSite& site, Level level, Category category, const char* format, Args... args);
+    
+    // 写完队列中的消息并停止写线程，之后的日志直接同步输出
+    void shutdown();
+    
+    // "trace"/"debug"/"info"/"warning"/"error"，无法识别时返回 false
+    static bool parseLevel(const std::string& text, Level& level);
+    static const char* levelName(Level level);
+    static const char* categoryName(Category category);
+};
+
+template<typename... Args>
+void Logger::write(CallSite& site, Level level, Category category, const char* text, Args... args) {
+    std::uint32_t suppressed = 0;
+    if (!admit(site, suppressed)) {
+        return;
+    }
+    
+    if (stopped.load(std::memory_order_acquire)) {
+        char line[MessageSize];
+        format(line, text, args...);
+        writeNow(level, category, suppressed, line);
+        return;
+    }
+    
+    std::uint64_t position;
+    Slot* slot = claim(position);
+    if (!slot) {
+        return; // 队列满，已计数
+    }
+    format(slot->text, text, args...);
+    publish(slot, position, level, category, suppressed);
+}
+
+#define LOG_CONCAT_IMPL(a, b) a##b
+#define LOG_CONCAT(a, b) LOG_CONCAT_IMPL(a, b)
+#define LOG_AT(level, category, ...) \
+    do { \
+        if (Logger::getInstance()->isEnabled(level)) { \
+            static Logger::CallSite LOG_CONCAT(logSite_, __LINE__); \
+            Logger::getInstance()->write(LOG_CONCAT(logSite_, __LINE__), level, Logger::category, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#if BRICKBREAKER_LOG_MIN_LEVEL <= 0
+#define LOG_TRACE(category, ...) LOG_AT(Logger::Trace, category, __VA_ARGS__)
+#else
+#define LOG_TRACE(category, ...) ((void)0)
+#endif
+#if BRICKBREAKER_LOG_MIN_LEVEL <= 1
+#define LOG_DEBUG(category, ...) LOG_AT(Logger::Debug, category, __VA_ARGS__)
+#else
+#define LOG_DEBUG(category, ...) ((void)0)
+#endif
+#if BRICKBREAKER_LOG_MIN_LEVEL <= 2
+#define LOG_INFO(category, ...) LOG_AT(Logger::Info, category, __VA_ARGS__)
+#else
+#define LOG_INFO(category, ...) ((void)0)
+#endif
+#if BRICKBREAKER_LOG_MIN_LEVEL <= 3
+#define LOG_WARN(category, ...) LOG_AT(Logger::Warning, category, __VA_ARGS__)
+#else
+#define LOG_WARN(category, ...) ((void)0)
+#endif
+#define LOG_ERROR(category, ...) LOG_AT(Logger::Error, category, __VA_ARGS__)
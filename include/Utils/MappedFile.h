@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// 只读内存映射文件（POSIX 使用 mmap，Windows 使用 MapViewOfFile）
+class MappedFile {
+private:
+    const unsigned char* data;
+    std::size_t size;
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    // 禁止拷贝，允许移动
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // 映射整个文件，失败返回false
+    bool open(const std::string& filename);
+
+    // 解除映射
+    void close();
+
+    bool isOpen() const;
+    const unsigned char* getData() const;
+    std::size_t getSize() const;
+};
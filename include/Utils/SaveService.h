@@ -0,0 +1,67 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 后台存档服务：主线程只拷贝状态（放进序列化函数里），序列化和写盘在工作线程完成
+// 同一文件在写入前的多次请求会合并成最后一次；写入采用 临时文件 + fsync + 原子重命名，
+// 写到一半断电时旧文件仍然完整。追加写（日志）按提交顺序执行，相邻的追加会拼成一次写入
+class SaveService {
+public:
+    using Serializer = std::function<void(std::vector<unsigned char>&)>;
+
+private:
+    // 单例实例
+    static SaveService* s_instance;
+
+    struct Job {
+        std::string filename;
+        Serializer serialize;                  // 整个文件替换
+        std::vector<unsigned char> appendData; // serialize 为空时追加这些字节
+    };
+
+    std::mutex mutex;
+    std::condition_variable wake;     // 有新任务或要求停止
+    std::condition_variable idle;     // 所有任务写完
+    std::vector<Job> pending;         // 按提交顺序；每个文件最多一个替换任务
+    bool busy;
+    bool stopping;
+    std::thread worker;               // 第一次提交时启动
+
+    std::vector<unsigned char> buffer; // 只在工作线程使用，反复复用
+
+    SaveService();
+
+    void run();
+    void write(const Job& job, std::vector<unsigned char>& out);
+    void enqueue(Job job);
+
+public:
+    ~SaveService();
+
+    // 获取单例实例
+    static SaveService* getInstance();
+
+    // 提交存档任务；serializer 应该持有状态的拷贝，会在工作线程中调用
+    void submit(const std::string& filename, Serializer serializer);
+
+    // 追加到文件末尾并 fsync（文件不存在时创建）；在同一文件之前提交的替换之后执行
+    void append(const std::string& filename, const void* data, std::size_t size);
+    
+    // 等待所有已提交的任务写完
+    void flush();
+
+    // 写完剩余任务并停止工作线程，之后的提交在调用线程中同步完成
+    void shutdown();
+
+    // 临时文件 + fsync + 原子重命名
+    static bool writeAtomically(const std::string& filename, const void* data, std::size_t size);
+    
+    // 追加写入并 fsync
+    static bool appendDurably(const std::string& filename, const void* data, std::size_t size);
+};
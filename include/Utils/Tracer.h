@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Chrome Trace Event 格式的事件追踪，生成的 JSON 可以直接用 Perfetto 或 chrome://tracing 打开
+// 每个线程写自己的缓冲区，后台线程定期把缓冲区换出来写入文件；
+// 只有定义了 BRICKBREAKER_TRACING（Debug 构建）时 TRACE_* 宏才会生成代码
+class Tracer {
+public:
+    struct Event {
+        const char* name;        // 必须是字符串字面量
+        std::int64_t timestamp;  // 纳秒，相对于 start()
+        std::int64_t value;      // 完整事件的持续时间（纳秒）或计数器的值
+        char phase;              // 'X' 完整事件，'C' 计数器，'i' 瞬时事件
+        char detail[47];         // 附加信息（例如文件名），过长时截断
+    };
+    
+    // 作用域事件：析构时记录一条带持续时间的完整事件
+    class Scope {
+    private:
+        const char* name;
+        const char* detail;      // 需要在作用域内保持有效
+        std::int64_t start;
+        bool active;
+    
+    public:
+        explicit Scope(const char* name, const char* detail = nullptr);
+        ~Scope();
+        
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+private:
+    struct ThreadBuffer {
+        std::mutex mutex;            // 只在写文件线程换出缓冲区时才会有竞争
+        std::vector<Event> events;
+        std::uint32_t tid;
+        const char* threadName;      // 写进文件一次（每次 start 之后）
+        bool nameWritten;
+        bool released;               // 线程已退出，剩余事件写完后回收
+    };
+    
+    // 当前线程的缓冲区和名字；线程退出时析构，把缓冲区交还给 Tracer
+    struct ThreadSlot {
+        ThreadBuffer* buffer = nullptr;
+        const char* name = nullptr;
+        
+        ~ThreadSlot();
+    };
+    
+    // 单例实例
+    static Tracer* s_instance;
+    static thread_local ThreadSlot t_slot;
+    
+    std::atomic<bool> enabled;
+    std::chrono::steady_clock::time_point origin;
+    
+    // 所有线程的缓冲区；线程退出后缓冲区进入空闲列表，给之后的新线程复用
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::vector<ThreadBuffer*> freeBuffers;
+    std::uint32_t nextTid;
+    
+    // 写文件线程
+    std::FILE* file;
+    bool firstEvent;
+    std::mutex writerMutex;
+    std::condition_variable wake;
+    bool stopping;
+    std::thread writer;
+    
+    Tracer();
+    
+    ThreadBuffer& localBuffer();
+    void releaseBuffer(ThreadBuffer* buffer);
+    void record(char phase, const char* name, std::int64_t timestamp, std::int64_t value, const char* detail);
+    void run();
+    void drain(std::vector<Event>& scratch);
+    void writeEvent(const Event& event, std::uint32_t tid);
+    void writeThreadName(const char* name, std::uint32_t tid);
+
+public:
+    ~Tracer();
+    
+    // 获取单例实例
+    static Tracer* getInstance();
+    
+    // 开始记录到文件（覆盖已有文件），失败返回 false
+    bool start(const std::string& filename);
+    
+    // 写完剩余事件并关闭文件
+    void stop();
+    
+    bool isEnabled() const { return enabled.load(std::memory_order_acquire); }
+    
+    // 距离 start() 的纳秒数
+    std::int64_t now() const;
+    
+    void complete(const char* name, std::int64_t start, const char* detail = nullptr);
+    void counter(const char* name, std::int64_t value);
+    void instant(const char* name, const char* detail = nullptr);
+    
+    // 给当前线程命名（在追踪开始前调用也有效；只记下名字，第一次记录事件时才分配缓冲区）
+    void setThreadName(const char* name);
+};
+
+inline Tracer::Scope::Scope(const char* name, const char* detail)
+    : name(name),
+      detail(detail),
+      start(0),
+      active(Tracer::getInstance()->isEnabled()) {
+    if (active) {
+        start = Tracer::getInstance()->now();
+    }
+}
+
+inline Tracer::Scope::~Scope() {
+    if (active) {
+        Tracer::getInstance()->complete(name, start, detail);
+    }
+}
+
+#ifdef BRICKBREAKER_TRACING
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+#define TRACE_SCOPE(name) Tracer::Scope TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define TRACE_SCOPE_DETAIL(name, detail) Tracer::Scope TRACE_CONCAT(traceScope_, __LINE__)(name, detail)
+#define TRACE_COUNTER(name, value) Tracer::getInstance()->counter(name, static_cast<std::int64_t>(value))
+#define TRACE_INSTANT(name) Tracer::getInstance()->instant(name)
+#define TRACE_THREAD_NAME(name) Tracer::getInstance()->setThreadName(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_SCOPE_DETAIL(name, detail) ((void)0)
+#define TRACE_COUNTER(name, value) ((void)0)
+#define TRACE_INSTANT(name) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#endif
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
 #include <random>
 #include <string>
 #include <sstream>
@@ -12,12 +15,40 @@ namespace Utils {
     // Random number generation
     class Random {
     private:
-        static std::mt19937 generator;
+        // 64位状态的随机数引擎（SplitMix64），整个状态可以直接写进存档
+        class Engine {
+        private:
+            std::uint64_t state;
+            
+        public:
+            using result_type = std::uint64_t;
+            
+            explicit Engine(std::uint64_t seed = 0) : state(seed) {}
+            
+            static constexpr result_type min() { return 0; }
+            static constexpr result_type max() { return ~static_cast<result_type>(0); }
+            
+            result_type operator()() {
+                std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                return z ^ (z >> 31);
+            }
+            
+            std::uint64_t getState() const { return state; }
+            void setState(std::uint64_t value) { state = value; }
+        };
+        
+        static Engine generator;
         
     public:
         // Initialize random number generator
         static void init();
         
+        // 读取和恢复随机数状态（存档用）
+        static std::uint64_t getState();
+        static void setState(std::uint64_t state);
+        
         // Generate integer within specified range
         static int getInt(int min, int max);
         
@@ -53,6 +84,10 @@ namespace Utils {
         // Format string
         template<typename... Args>
         static std::string format(const std::string& format, Args... args);
+        
+        // 格式化到已有的 sf::String，复用它的容量（只支持 ASCII）
+        template<typename... Args>
+        static void formatTo(sf::String& out, const char* format, Args... args);
     };
     
     // Geometry calculations
@@ -164,13 +199,30 @@ const T& Utils::Random::getItem(const std::vector<T>& items) {
 
 template<typename... Args>
 std::string Utils::String::format(const std::string& format, Args... args) {
-    int size = snprintf(nullptr, 0, format.c_str(), args...) + 1; // Extra space for null terminator
-    if (size <= 0) {
+    // 先格式化到栈上的缓冲区，放得下时只构造一次结果字符串
+    char stackBuffer[256];
+    int size = snprintf(stackBuffer, sizeof(stackBuffer), format.c_str(), args...);
+    if (size < 0) {
         throw std::runtime_error("Error formatting string");
     }
+    if (static_cast<std::size_t>(size) < sizeof(stackBuffer)) {
+        return std::string(stackBuffer, stackBuffer + size);
+    }
     
-    std::unique_ptr<char[]> buf(new char[size]);
-    snprintf(buf.get(), size, format.c_str(), args...);
+    std::string result(static_cast<std::size_t>(size), '\0');
+    snprintf(&result[0], result.size() + 1, format.c_str(), args...);
+    return result;
+}
+
+template<typename... Args>
+void Utils::String::formatTo(sf::String& out, const char* format, Args... args) {
+    char buffer[128];
+    int size = snprintf(buffer, sizeof(buffer), format, args...);
+    size = std::min(size, static_cast<int>(sizeof(buffer)) - 1);
     
-    return std::string(buf.get(), buf.get() + size - 1); // Excluding null terminator
+    // clear 保留容量，逐个追加的单字符串在小字符串缓冲区里
+    out.clear();
+    for (int i = 0; i < size; ++i) {
+        out += static_cast<char32_t>(static_cast<unsigned char>(buffer[i]));
+    }
 }
\ No newline at end of file
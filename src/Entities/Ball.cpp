@@ -4,7 +4,7 @@
 
 Ball::Ball() : Entity(), velocity(0.0f, 0.0f), radius(10.0f) {
     // Get ball speed from config
-    speed = Config::getInstance().getValue("game.ball_speed", 300.0f);
+    speed = Config::getInstance().getSettings().ballSpeed;
 }
 
 Ball::Ball(const sf::Vector2f& pos, float radius) 
@@ -12,7 +12,7 @@ Ball::Ball(const sf::Vector2f& pos, float radius)
       velocity(0.0f, 0.0f), 
       radius(radius) {
     // Get ball speed from config
-    speed = Config::getInstance().getValue("game.ball_speed", 300.0f);
+    speed = Config::getInstance().getSettings().ballSpeed;
 }
 
 void Ball::update(float deltaTime) {
@@ -42,6 +42,15 @@ void Ball::setVelocity(const sf::Vector2f& vel) {
     }
 }
 
+void Ball::setSpeed(float newSpeed) {
+    speed = newSpeed;
+    
+    float length = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
+    if (length > 0.0f) {
+        velocity = velocity / length * speed;
+    }
+}
+
 sf::Vector2f Ball::getVelocity() const {
     return velocity;
 }
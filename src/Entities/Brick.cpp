@@ -7,7 +7,8 @@ Brick::Brick()
       hitPoints(1), 
       score(100), 
       breakable(true),
-      color(sf::Color::White) {
+      color(sf::Color::White),
+      index(-1) {
 }
 
 Brick::Brick(const sf::Vector2f& pos, const sf::Vector2f& size, int hitPoints, int score)
@@ -15,7 +16,8 @@ Brick::Brick(const sf::Vector2f& pos, const sf::Vector2f& size, int hitPoints, i
       hitPoints(hitPoints), 
       score(score), 
       breakable(true),
-      color(sf::Color::White) {
+      color(sf::Color::White),
+      index(-1) {
 }
 
 void Brick::update(float deltaTime) {
@@ -57,6 +59,14 @@ void Brick::setBreakable(bool breakable) {
     this->breakable = breakable;
 }
 
+int Brick::getIndex() const {
+    return index;
+}
+
+void Brick::setIndex(int index) {
+    this->index = index;
+}
+
 void Brick::hit() {
     if (breakable) {
         hitPoints--;
@@ -71,12 +81,15 @@ void Brick::hit() {
 }
 
 void Brick::updateColorFromHitPoints() {
-    // Get colors from config or use defaults
-    sf::Color color1 = Config::getInstance().getValue("colors.brick1", sf::Color::Red);
-    sf::Color color2 = Config::getInstance().getValue("colors.brick2", sf::Color::Yellow);
-    sf::Color color3 = Config::getInstance().getValue("colors.brick3", sf::Color::Green);
-    sf::Color color4 = Config::getInstance().getValue("colors.brick4", sf::Color::Blue);
-    sf::Color color5 = Config::getInstance().getValue("colors.brick5", sf::Color(128, 0, 128));
+    // Get colors from config (defaults come from the settings table)
+    // 砖块也会在预取线程中创建，取只读快照而不是主线程的 getSettings()
+    std::shared_ptr<const GameSettings> snapshot = Config::getInstance().getSnapshot();
+    const GameSettings& settings = *snapshot;
+    const sf::Color& color1 = settings.brickColor1;
+    const sf::Color& color2 = settings.brickColor2;
+    const sf::Color& color3 = settings.brickColor3;
+    const sf::Color& color4 = settings.brickColor4;
+    const sf::Color& color5 = settings.brickColor5;
     
     // Set color based on hit points
     switch (hitPoints) {
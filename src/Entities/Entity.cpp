@@ -1,4 +1,5 @@
 #include "Entities/Entity.h"
+#include "Utils/FrameProfiler.h"
 
 Entity::Entity() : position(0, 0), size(0, 0), active(true), speed(0.0f) {
     // sprite will be initialized in setTexture
@@ -12,6 +13,14 @@ Entity::Entity(const sf::Vector2f& pos, const sf::Vector2f& size)
 void Entity::render(sf::RenderWindow& window) {
     if (active && sprite) {
         window.draw(*sprite);
+        FrameProfiler::getInstance()->countDrawCall();
+    }
+}
+
+void Entity::renderTransformed(sf::RenderWindow& window, const sf::RenderStates& states) {
+    if (active && sprite) {
+        window.draw(*sprite, states);
+        FrameProfiler::getInstance()->countDrawCall();
     }
 }
 
@@ -34,6 +43,10 @@ bool Entity::isActive() const {
     return active;
 }
 
+float Entity::getSpeed() const {
+    return speed;
+}
+
 void Entity::setPosition(const sf::Vector2f& pos) {
     position = pos;
     if (sprite) {
@@ -67,7 +80,12 @@ void Entity::setActive(bool isActive) {
 
 void Entity::setTexture(const sf::Texture& texture) {
     // In SFML 3.0.0, a texture must be provided when creating a Sprite
-    sprite = std::make_unique<sf::Sprite>(texture);
+    // 已有精灵时直接换纹理（复用的球不再重新分配）
+    if (sprite) {
+        sprite->setTexture(texture, true);
+    } else {
+        sprite.emplace(texture);
+    }
     sprite->setPosition(position);
     setSize(size); // Update size
 }
\ No newline at end of file
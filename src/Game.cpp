@@ -4,31 +4,107 @@
 #include "States/PauseState.h"
 #include "States/GameOverState.h"
 #include "Utils/Config.h"
+#include "Utils/ConfigWatcher.h"
 #include "Utils/Utils.h"
+#include "Utils/SaveService.h"
+#include "Utils/FrameProfiler.h"
+#include "Utils/Tracer.h"
+#include "Utils/FlightRecorder.h"
+#include "Utils/AllocTracker.h"
+#include "Utils/FrameArena.h"
 #include "Managers/AssetManager.h"
-#include <iostream>
+#include "Managers/MusicPlayer.h"
+#include "Utils/Logger.h"
+#include <algorithm>
 
-Game::Game() : running(false), paused(false), deltaTime(0.0f), showingSplash(true), splashTimer(0.0f) {
+namespace {
+    void applyLogLevel(const std::string& text) {
+        Logger::Level level;
+        if (Logger::parseLevel(text, level)) {
+            Logger::getInstance()->setLevel(level);
+        } else {
+            LOG_WARN(Config, "Unknown log level: %s", text.c_str());
+        }
+    }
+}
+
+Game::Game()
+    : running(false), paused(false), deltaTime(0.0f), showingSplash(true), splashTimer(0.0f),
+      allocationTestSeconds(0.0f), allocationTestTimer(0.0f), exitCode(0), autopilot(false),
+      headless(false), headlessSize(0, 0) {
 }
 
 Game::~Game() {
-    // Save configuration before exiting
-    Config::getInstance().save();
+    // 停止配置热重载
+    ConfigWatcher::getInstance()->stop();
+    
+    // 退出时只在这里保存一次配置，下面 shutdown 时写完；分配测试和无窗口运行不写配置
+    if (allocationTestSeconds <= 0.0f && !headless) {
+        Config::getInstance().saveAsync();
+    }
     
     // Clear state stack
     while (!states.empty()) {
         states.pop();
     }
+    
+    // 退出前等待所有存档写完
+    SaveService::getInstance()->shutdown();
+    
+    // 最后关闭追踪文件，包含存档线程的事件
+    Tracer::getInstance()->stop();
+    
+    // 写完剩余的日志，之后的日志直接同步输出
+    Logger::getInstance()->shutdown();
 }
 
 void Game::init() { //创建配置、工具、窗口和初始化资源、push状态
     // Load configuration
     if (!Config::getInstance().load()) {
-        std::cout << "Failed to load config.ini, using default settings" << std::endl;
+        LOG_WARN(Config, "Failed to load config.ini, using default settings");
         // Save default configuration
         Config::getInstance().save();
     }
     
+    // 日志级别、日志文件和限流，修改配置后立即生效
+    const GameSettings& logSettings = Config::getInstance().getSettings();
+    applyLogLevel(logSettings.logLevel);
+    Logger::getInstance()->setFile(logSettings.logFile);
+    Logger::getInstance()->setRateLimit(logSettings.logRateLimit);
+    Config::getInstance().subscribe(Settings::logLevel, [](const std::string& level) {
+        applyLogLevel(level);
+    });
+    Config::getInstance().subscribe(Settings::logFile, [](const std::string& file) {
+        Logger::getInstance()->setFile(file);
+    });
+    Config::getInstance().subscribe(Settings::logRateLimit, [](const int& perSecond) {
+        Logger::getInstance()->setRateLimit(perSecond);
+    });
+    
+#ifdef BRICKBREAKER_TRACING
+    // 配置了追踪文件时记录 Chrome Trace 格式的事件
+    const std::string& traceFile = Config::getInstance().getSettings().traceFile;
+    if (!traceFile.empty()) {
+        Tracer::getInstance()->start(traceFile);
+    }
+#endif
+    
+    // 配置文件改动后在下一帧生效
+    ConfigWatcher::getInstance()->start(Config::getInstance().getConfigFilePath(), Config::getInstance().getSettings());
+    
+    // 帧耗时统计（运行时按F3切换）
+    FrameProfiler::getInstance()->setOverlayVisible(Config::getInstance().getSettings().frameProfiler);
+    
+    // 卡顿记录：帧耗时超过预算时写出最近几秒的记录，修改配置后立即生效
+    const GameSettings& debugSettings = Config::getInstance().getSettings();
+    FlightRecorder::getInstance()->configure(debugSettings.frameBudgetMs, debugSettings.flightRecorderSeconds);
+    Config::getInstance().subscribe(Settings::frameBudgetMs, [](const float& budget) {
+        FlightRecorder::getInstance()->configure(budget, Config::getInstance().getSettings().flightRecorderSeconds);
+    });
+    Config::getInstance().subscribe(Settings::flightRecorderSeconds, [](const float& seconds) {
+        FlightRecorder::getInstance()->configure(Config::getInstance().getSettings().frameBudgetMs, seconds);
+    });
+    
     // Initialize random number generator
     Utils::Random::init();
     
@@ -36,10 +112,11 @@ void Game::init() { //创建配置、工具、窗口和初始化资源、push状
     Utils::Time::init();
     
     // Initialize window
-    int width = Config::getInstance().getValue("window.width", 800);
-    int height = Config::getInstance().getValue("window.height", 600);
-    std::string title = Config::getInstance().getValue("window.title", std::string("Brick Breaker"));
-    bool fullscreen = Config::getInstance().getValue("window.fullscreen", false);
+    const GameSettings& settings = Config::getInstance().getSettings();
+    int width = settings.windowWidth;
+    int height = settings.windowHeight;
+    const std::string& title = settings.windowTitle;
+    bool fullscreen = settings.windowFullscreen;
     
     // SFML 3.0.0 window creation
     if (fullscreen) {
@@ -49,12 +126,10 @@ void Game::init() { //创建配置、工具、窗口和初始化资源、push状
     }
     
     // 设置垂直同步
-    bool vsync = Config::getInstance().getValue("window.vsync", true);
-    window.setVerticalSyncEnabled(vsync);
+    window.setVerticalSyncEnabled(settings.windowVsync);
     
     // 设置帧率限制
-    int frameRateLimit = Config::getInstance().getValue("window.framerate_limit", 60);
-    window.setFramerateLimit(frameRateLimit);
+    window.setFramerateLimit(static_cast<unsigned int>(settings.framerateLimit));
     
     // Initialize resources
     initResources();
@@ -64,9 +139,44 @@ void Game::init() { //创建配置、工具、窗口和初始化资源、push状
     
     // Set running flag
     running = true;
+    
+    if (allocationTestSeconds > 0.0f) {
+        startAllocationTest();
+    } else if (autopilot) {
+        LOG_INFO(Core, "Autopilot: skill %.2f, reaction %.2f s, simulation speed x%d",
+                 settings.autopilotSkill, settings.autopilotReaction, std::max(1, settings.simulationSpeed));
+        startAutoPlay();
+    }
+}
+
+void Game::initHeadless(const sf::Vector2u& size) {
+    headless = true;
+    headlessSize = size;
+    showingSplash = false;
+    
+    Utils::Random::init();
+    Utils::Time::init();
+    
+    // 没有加载音效；音乐也关掉，不打开音频设备
+    MusicPlayer::getInstance()->configure(0.0f, false, 100, 2);
+    
+    running = true;
+}
+
+void Game::simulate(float deltaTime) {
+    FrameArena::getInstance()->reset();
+    this->deltaTime = deltaTime;
+    update();
 }
 
 void Game::initResources() { //加载纹理、字体和音效
+    // 如果存在资源包则挂载，否则从 resources/ 下的松散文件加载（开发模式）
+    const GameSettings& settings = Config::getInstance().getSettings();
+    const std::string& packFile = settings.assetPackFile;
+    if (Utils::File::exists(packFile)) {
+        AssetManager::getInstance()->mountPack(packFile);
+    }
+    
     // Load textures
     AssetManager::getInstance()->loadTexture("ball", "resources/textures/ball.png");
     AssetManager::getInstance()->loadTexture("paddle", "resources/textures/paddle.png");
@@ -88,10 +198,23 @@ void Game::initResources() { //加载纹理、字体和音效
     AssetManager::getInstance()->loadSoundBuffer("break", "resources/sounds/break.wav");
     AssetManager::getInstance()->loadSoundBuffer("ball_windows", "resources/sounds/ball_windows.wav");
     
-    // Create sounds
-    AssetManager::getInstance()->createSound("hit", "hit");
-    AssetManager::getInstance()->createSound("break", "break");
-    AssetManager::getInstance()->createSound("ball_windows", "ball_windows");
+    // 音效通道池设置
+    AssetManager::getInstance()->configureSound(
+        settings.soundVolume,
+        settings.soundEnabled,
+        static_cast<std::size_t>(settings.soundVoices));
+    
+    // 背景音乐：流式播放，解码缓冲区大小可配置
+    MusicPlayer::getInstance()->configure(
+        settings.musicVolume,
+        settings.soundEnabled,
+        static_cast<unsigned int>(settings.musicBufferMs),
+        static_cast<std::size_t>(settings.musicBufferChunks));
+    
+    // Create sounds（优先级：挡板 > 砖块 > 墙壁）
+    AssetManager::getInstance()->createSound("hit", "hit", 3, 2);
+    AssetManager::getInstance()->createSound("break", "break", 2, 4);
+    AssetManager::getInstance()->createSound("ball_windows", "ball_windows", 1, 3);
 }
 
 void Game::initSplashScreen() {
@@ -122,12 +245,21 @@ void Game::initSplashScreen() {
 }
 
 void Game::run() { //主循环:event、update、render
+    TRACE_THREAD_NAME("main");
+    AllocTracker::TagScope allocationTag(AllocTracker::General);
+    
     if (!running) {
         init();
     }
     
     // 主循环
     while (running && window.isOpen()) {
+        // 上一帧的临时内存整体回收
+        FrameArena::getInstance()->reset();
+        
+        TRACE_SCOPE("frame");
+        FrameProfiler::getInstance()->beginFrame();
+        
         // Calculate delta time
         deltaTime = clock.restart().asSeconds();
         
@@ -142,14 +274,99 @@ void Game::run() { //主循环:event、update、render
         }
         
         // Handle events
-        handleEvents();
+        {
+            TRACE_SCOPE("Game::handleEvents");
+            FrameProfiler::Scope scope(FrameProfiler::Events);
+            handleEvents();
+        }
         
         // Update game logic
-        update();
+        {
+            TRACE_SCOPE("Game::update");
+            update();
+        }
+        
+        // 播放本帧触发的音效
+        AssetManager::getInstance()->updateSounds();
         
         // Render
-        render();
+        {
+            TRACE_SCOPE("Game::render");
+            render();
+        }
+        
+        FrameProfiler::getInstance()->endFrame();
+        FlightRecorder::getInstance()->endFrame();
+        AllocTracker::endFrame();
+        
+        if (allocationTestSeconds > 0.0f) {
+            updateAllocationTest();
+        }
+    }
+}
+
+void Game::setAllocationTest(float seconds) {
+    allocationTestSeconds = seconds;
+}
+
+void Game::setAutopilot(bool enabled) {
+    autopilot = enabled;
+}
+
+int Game::getExitCode() const {
+    return exitCode;
+}
+
+void Game::startAllocationTest() {
+    if (!AllocTracker::isAvailable()) {
+        LOG_ERROR(Core, "Allocation test needs a build with BRICKBREAKER_ALLOC_TRACKING");
+        exitCode = 1;
+        running = false;
+        return;
     }
+    
+    startAutoPlay();
+    
+    // 前两秒的稳态帧用来让字形缓存和容器容量长到位
+    AllocTracker::setGuard(true, 120);
+    allocationTestTimer = 0.0f;
+    LOG_INFO(Core, "Allocation test: playing for %.1f s", allocationTestSeconds);
+}
+
+void Game::startAutoPlay() {
+    showingSplash = false;
+    auto playState = std::make_unique<PlayState>(this);
+    // 在 init 之前打开：直接开始新的一局，整个过程不读写玩家的存档
+    playState->setAutoPlay(true);
+    pushState(std::move(playState));
+}
+
+void Game::updateAllocationTest() {
+    allocationTestTimer += deltaTime;
+    
+    // 时间到，或者这一局已经结束（不再是 PlayState）
+    bool finished = allocationTestTimer >= allocationTestSeconds ||
+                    dynamic_cast<PlayState*>(getCurrentState()) == nullptr;
+    if (!finished) {
+        return;
+    }
+    
+    std::uint64_t violations = AllocTracker::getViolations();
+    if (violations > 0) {
+        LOG_ERROR(Core, "Allocation test FAILED: %llu steady-state frames allocated", static_cast<unsigned long long>(violations));
+        exitCode = 1;
+    } else {
+        LOG_INFO(Core, "Allocation test passed: no steady-state allocations in %.1f s", allocationTestTimer);
+    }
+    
+    LOG_INFO(Core, "Frame arena: peak %zu B, average %zu B, capacity %zu B, %llu overflowing frames",
+             FrameArena::getInstance()->getPeakBytes(), FrameArena::getInstance()->getAverageBytes(),
+             FrameArena::getInstance()->getCapacity(),
+             static_cast<unsigned long long>(FrameArena::getInstance()->getOverflowFrames()));
+    
+    // 不走 quit()：测试不写存档（自动挡板不存档），~Game 中也不保存配置
+    running = false;
+    window.close();
 }
 
 void Game::handleEvents() { //state->handleEvents
@@ -162,6 +379,18 @@ void Game::handleEvents() { //state->handleEvents
             quit();
         }
         
+        // F3 切换帧耗时叠加层
+        if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+            FlightRecorder::getInstance()->record(FlightRecorder::KeyPressed, static_cast<int>(keyPressed->code));
+            if (keyPressed->code == sf::Keyboard::Key::F3) {
+                FrameProfiler::getInstance()->toggleOverlay();
+            }
+        } else if (const auto* keyReleased = event.getIf<sf::Event::KeyReleased>()) {
+            FlightRecorder::getInstance()->record(FlightRecorder::KeyReleased, static_cast<int>(keyReleased->code));
+        } else if (const auto* mouse = event.getIf<sf::Event::MouseButtonPressed>()) {
+            FlightRecorder::getInstance()->record(FlightRecorder::MouseButton, static_cast<int>(mouse->button), mouse->position.x);
+        }
+        
         // 如果显示启动页，任意键跳过
         if (showingSplash && event.is<sf::Event::KeyPressed>()) {
             showingSplash = false;
@@ -177,51 +406,58 @@ void Game::handleEvents() { //state->handleEvents
 }
 
 void Game::update() { //state->update
+    // 应用热重载的配置（触发订阅回调）
+    ConfigWatcher::getInstance()->applyPending();
+    
+    // 推进背景音乐的淡入淡出
+    MusicPlayer::getInstance()->update(deltaTime);
+    
     // 如果显示启动页，不更新游戏状态
     if (showingSplash) {
         return;
     }
     
-    if (!paused && !states.empty()) {
-        states.top()->update(deltaTime);
+    // simulation_speed 大于1时每帧模拟多步（挂机快进）；状态切换或暂停后本帧不再继续
+    int steps = std::max(1, Config::getInstance().getSettings().simulationSpeed);
+    GameState* state = getCurrentState();
+    for (int step = 0; step < steps && !paused && state && state == getCurrentState(); ++step) {
+        state->update(deltaTime);
     }
 }
 
 void Game::render() { //state->render
-    window.clear(Config::getInstance().getValue("colors.background", sf::Color(20, 20, 50)));
-    
-    // 如果显示启动页，渲染启动页
-    if (showingSplash) {
-        window.draw(*splashSprite);
-    }
-    // 否则渲染当前状态
-    else if (!states.empty()) {
-        states.top()->render(window);
+    FrameProfiler* profiler = FrameProfiler::getInstance();
+    {
+        FrameProfiler::Scope scope(FrameProfiler::Render);
+        window.clear(Config::getInstance().getSettings().backgroundColor);
+        
+        // 如果显示启动页，渲染启动页
+        if (showingSplash) {
+            window.draw(*splashSprite);
+            profiler->countDrawCall();
+        }
+        // 否则渲染当前状态
+        else if (!states.empty()) {
+            states.top()->render(window);
+        }
+        
+        profiler->renderOverlay(window, deltaTime);
     }
     
+    FrameProfiler::Scope scope(FrameProfiler::Display);
     window.display();
 }
 
 void Game::quit() { //直接关闭窗口
-    // 保存游戏状态
+    // 保存游戏状态（在后台写盘，~Game 中等待写完）
     if (!states.empty()) {
-        GameState* currentState = states.top().get();
-        PlayState* playState = dynamic_cast<PlayState*>(currentState);
+        PlayState* playState = dynamic_cast<PlayState*>(states.top().get());
         if (playState) {
-            std::cout << "Saving game state before exit..." << std::endl;
             playState->saveGameState();
-        } else {
-            std::cout << "Current state is not PlayState, no game state to save" << std::endl;
         }
-    } else {
-        std::cout << "No active game states, nothing to save" << std::endl;
     }
     
-    // Save configuration before exiting
-    std::cout << "Saving configuration..." << std::endl;
-    bool configSaved = Config::getInstance().save();
-    std::cout << "Configuration save " << (configSaved ? "successful" : "failed") << std::endl;
-    
+    // 配置在 ~Game 中保存（退出时只写一次）
     running = false;
     window.close();
 }
@@ -250,6 +486,7 @@ void Game::pushState(std::unique_ptr<GameState> state) {
     
     // Initialize and push new state
     state->init();
+    FlightRecorder::getInstance()->pushState(state->getName());
     states.push(std::move(state));
     states.top()->onEnter();
 }
@@ -259,6 +496,7 @@ void Game::popState() {
         // Exit current state
         states.top()->onExit();
         states.pop();
+        FlightRecorder::getInstance()->popState();
         
         // Resume previous state
         if (!states.empty()) {
@@ -275,10 +513,12 @@ void Game::changeState(std::unique_ptr<GameState> state) {
     if (!states.empty()) {
         states.top()->onExit();
         states.pop();
+        FlightRecorder::getInstance()->popState();
     }
     
     // Initialize and push new state
     state->init();
+    FlightRecorder::getInstance()->pushState(state->getName());
     states.push(std::move(state));
     states.top()->onEnter();
 }
@@ -291,6 +531,10 @@ sf::RenderWindow& Game::getWindow() {
     return window;
 }
 
+sf::Vector2u Game::getSize() const {
+    return headless ? headlessSize : window.getSize();
+}
+
 float Game::getFPS() const {
     return deltaTime > 0 ? 1.0f / deltaTime : 0.0f;
 }
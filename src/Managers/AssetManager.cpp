@@ -1,6 +1,8 @@
 #include "Managers/AssetManager.h"
-#include <iostream>
+#include "Utils/Tracer.h"
+#include "Utils/Logger.h"
 #include <stdexcept>
+#include <utility>
 
 // Static member initialization
 AssetManager* AssetManager::s_instance = nullptr;
@@ -10,10 +12,10 @@ AssetManager::AssetManager() {
 
 AssetManager::~AssetManager() {
     // Clean up resources
-    textures.clear();
-    fonts.clear();
+    soundPool.stopAll();
     soundBuffers.clear();
-    sounds.clear();
+    fonts.clear();
+    textures.clear();
 }
 
 AssetManager* AssetManager::getInstance() {
@@ -25,93 +27,213 @@ AssetManager* AssetManager::getInstance() {
 
 void AssetManager::init() {
     // Initialize resource manager
-    std::cout << "AssetManager initialized" << std::endl;
+    LOG_DEBUG(Assets, "AssetManager initialized");
+}
+
+bool AssetManager::mountPack(const std::string& filename) {
+    if (!pack.open(filename)) {
+        return false;
+    }
+    LOG_INFO(Assets, "Mounted asset pack: %s (%zu entries)", filename.c_str(), static_cast<std::size_t>(pack.getEntryCount()));
+    return true;
+}
+
+void AssetManager::unmountPack() {
+    // 字体直接引用映射内存，卸载前必须先释放
+    fonts.clear();
+    fontIndex.clear();
+    pack.close();
+}
+
+bool AssetManager::hasPack() const {
+    return pack.isOpen();
 }
 
-void AssetManager::loadTexture(const std::string& name, const std::string& filename) {
+AssetBlob AssetManager::findPacked(const std::string& filename) const {
+    return pack.find(filename);
+}
+
+template<typename T>
+std::uint32_t AssetManager::store(std::deque<T>& storage, std::unordered_map<AssetId, IndexEntry>& index,
+                                  const std::string& name, T&& asset) {
+    AssetId id(name);
+    auto it = index.find(id);
+    if (it != index.end()) {
+        if (it->second.name != name) {
+            LOG_ERROR(Assets, "Asset id collision: %s and %s", name.c_str(), it->second.name.c_str());
+            return TextureHandle::Invalid;
+        }
+        // 原地替换，已发出的句柄和引用保持有效
+        storage[it->second.index] = std::move(asset);
+        return it->second.index;
+    }
+
+    storage.push_back(std::move(asset));
+    std::uint32_t slot = static_cast<std::uint32_t>(storage.size() - 1);
+    index.emplace(id, IndexEntry{slot, name});
+    return slot;
+}
+
+std::uint32_t AssetManager::lookup(const std::unordered_map<AssetId, IndexEntry>& index, AssetId id) {
+    auto it = index.find(id);
+    return it != index.end() ? it->second.index : TextureHandle::Invalid;
+}
+
+TextureHandle AssetManager::loadTexture(const std::string& name, const std::string& filename) {
+    TRACE_SCOPE_DETAIL("AssetManager::loadTexture", filename.c_str());
     sf::Texture texture;
-    if (texture.loadFromFile(filename)) {
-        textures[name] = texture;
-        std::cout << "Loaded texture: " << name << " from " << filename << std::endl;
-    } else {
-        std::cerr << "Failed to load texture: " << filename << std::endl;
+    AssetBlob blob = pack.find(filename);
+    if (blob ? texture.loadFromMemory(blob.data, blob.size) : texture.loadFromFile(filename)) {
+        TextureHandle handle{store(textures, textureIndex, name, std::move(texture))};
+        LOG_DEBUG(Assets, "Loaded texture: %s from %s", name.c_str(), filename.c_str());
+        return handle;
     }
+    LOG_ERROR(Assets, "Failed to load texture: %s", filename.c_str());
+    return {};
 }
 
-bool AssetManager::loadFont(const std::string& name, const std::string& filename) {
+FontHandle AssetManager::loadFont(const std::string& name, const std::string& filename) {
+    TRACE_SCOPE_DETAIL("AssetManager::loadFont", filename.c_str());
     try {
         sf::Font font;
-        if (font.openFromFile(filename)) {
-            fonts[name] = font;
-            std::cout << "Font loaded successfully: " << name << std::endl;
-            return true;
+        // openFromMemory不拷贝数据，字体在整个生命周期内读取映射内存
+        AssetBlob blob = pack.find(filename);
+        if (blob ? font.openFromMemory(blob.data, blob.size) : font.openFromFile(filename)) {
+            FontHandle handle{store(fonts, fontIndex, name, std::move(font))};
+            LOG_DEBUG(Assets, "Loaded font: %s", name.c_str());
+            return handle;
         } else {
-            std::cerr << "Failed to load font: " << filename << std::endl;
-            return false;
+            LOG_ERROR(Assets, "Failed to load font: %s", filename.c_str());
+            return {};
         }
     } catch (const std::exception& e) {
-        std::cerr << "Font loading exception: " << e.what() << std::endl;
-        return false;
+        LOG_ERROR(Assets, "Font loading exception: %s", e.what());
+        return {};
     }
 }
 
-void AssetManager::loadSoundBuffer(const std::string& name, const std::string& filename) {
+SoundBufferHandle AssetManager::loadSoundBuffer(const std::string& name, const std::string& filename) {
+    TRACE_SCOPE_DETAIL("AssetManager::loadSoundBuffer", filename.c_str());
     sf::SoundBuffer buffer;
-    if (buffer.loadFromFile(filename)) {
-        soundBuffers[name] = buffer;
-        std::cout << "Loaded sound buffer: " << name << " from " << filename << std::endl;
-    } else {
-        std::cerr << "Failed to load sound buffer: " << filename << std::endl;
+    AssetBlob blob = pack.find(filename);
+    if (blob ? buffer.loadFromMemory(blob.data, blob.size) : buffer.loadFromFile(filename)) {
+        SoundBufferHandle handle{store(soundBuffers, soundBufferIndex, name, std::move(buffer))};
+        LOG_DEBUG(Audio, "Loaded sound buffer: %s from %s", name.c_str(), filename.c_str());
+        return handle;
     }
+    LOG_ERROR(Audio, "Failed to load sound buffer: %s", filename.c_str());
+    return {};
+}
+
+TextureHandle AssetManager::findTexture(AssetId id) const {
+    return {lookup(textureIndex, id)};
+}
+
+FontHandle AssetManager::findFont(AssetId id) const {
+    return {lookup(fontIndex, id)};
+}
+
+SoundBufferHandle AssetManager::findSoundBuffer(AssetId id) const {
+    return {lookup(soundBufferIndex, id)};
+}
+
+SoundHandle AssetManager::findSound(AssetId id) const {
+    return {lookup(soundIndex, id)};
+}
+
+bool AssetManager::hasTexture(AssetId id) const {
+    return findTexture(id).isValid();
+}
+
+bool AssetManager::hasTexture(const std::string& name) const {
+    return hasTexture(AssetId(name));
+}
+
+bool AssetManager::hasFont(AssetId id) const {
+    return findFont(id).isValid();
 }
 
-bool AssetManager::hasTexture(const std::string& name) {
-    return textures.find(name) != textures.end();
+bool AssetManager::hasFont(const std::string& name) const {
+    return hasFont(AssetId(name));
 }
 
-bool AssetManager::hasFont(const std::string& name) {
-    return fonts.find(name) != fonts.end();
+sf::Texture& AssetManager::getTexture(TextureHandle handle) {
+    return textures[handle.index];
+}
+
+sf::Font& AssetManager::getFont(FontHandle handle) {
+    return fonts[handle.index];
+}
+
+sf::SoundBuffer& AssetManager::getSoundBuffer(SoundBufferHandle handle) {
+    return soundBuffers[handle.index];
 }
 
 sf::Texture& AssetManager::getTexture(const std::string& name) {
-    auto it = textures.find(name);
-    if (it != textures.end()) {
-        return it->second;
+    TextureHandle handle = findTexture(AssetId(name));
+    if (handle.isValid()) {
+        return getTexture(handle);
     }
     throw std::runtime_error("Texture not found: " + name);
 }
 
 sf::Font& AssetManager::getFont(const std::string& name) {
-    auto it = fonts.find(name);
-    if (it != fonts.end()) {
-        return it->second;
+    FontHandle handle = findFont(AssetId(name));
+    if (handle.isValid()) {
+        return getFont(handle);
     }
     throw std::runtime_error("Font not found: " + name);
 }
 
 sf::SoundBuffer& AssetManager::getSoundBuffer(const std::string& name) {
-    auto it = soundBuffers.find(name);
-    if (it != soundBuffers.end()) {
-        return it->second;
+    SoundBufferHandle handle = findSoundBuffer(AssetId(name));
+    if (handle.isValid()) {
+        return getSoundBuffer(handle);
     }
     throw std::runtime_error("Sound buffer not found: " + name);
 }
 
-void AssetManager::createSound(const std::string& soundName, const std::string& bufferName) {
-    auto it = soundBuffers.find(bufferName);
-    if (it != soundBuffers.end()) {
-        sounds.emplace(soundName, sf::Sound(it->second));
-        std::cout << "Created sound: " << soundName << " from buffer: " << bufferName << std::endl;
-    } else {
-        std::cerr << "Failed to create sound: " << soundName << " - buffer not found: " << bufferName << std::endl;
+SoundHandle AssetManager::createSound(const std::string& soundName, const std::string& bufferName,
+                                      int priority, unsigned int maxInstances) {
+    SoundBufferHandle buffer = findSoundBuffer(AssetId(bufferName));
+    if (!buffer.isValid()) {
+        LOG_ERROR(Audio, "Failed to create sound: %s - buffer not found: %s", soundName.c_str(), bufferName.c_str());
+        return {};
     }
+
+    const sf::SoundBuffer& soundBuffer = soundBuffers[buffer.index];
+    AssetId id(soundName);
+    auto it = soundIndex.find(id);
+    if (it != soundIndex.end()) {
+        if (it->second.name != soundName) {
+            LOG_ERROR(Audio, "Asset id collision: %s and %s", soundName.c_str(), it->second.name.c_str());
+            return {};
+        }
+        soundPool.redefineSound(it->second.index, soundBuffer, priority, maxInstances);
+        return {it->second.index};
+    }
+
+    std::uint32_t index = soundPool.addSound(soundBuffer, priority, maxInstances);
+    soundIndex.emplace(id, IndexEntry{index, soundName});
+    LOG_DEBUG(Audio, "Created sound: %s from buffer: %s", soundName.c_str(), bufferName.c_str());
+    return {index};
+}
+
+void AssetManager::configureSound(float volume, bool enabled, std::size_t voiceCount) {
+    soundPool.setVoiceCount(voiceCount);
+    soundPool.setVolume(volume);
+    soundPool.setEnabled(enabled);
 }
 
 void AssetManager::playSound(const std::string& name) {
-    auto it = sounds.find(name);
-    if (it != sounds.end()) {
-        it->second.play();
+    SoundHandle handle = findSound(AssetId(name));
+    if (handle.isValid()) {
+        playSound(handle);
     } else {
-        std::cerr << "Sound not found: " << name << std::endl;
+        LOG_WARN(Audio, "Sound not found: %s", name.c_str());
     }
 }
+
+void AssetManager::updateSounds() {
+    soundPool.flush();
+}
@@ -0,0 +1,84 @@
+#include "Managers/AssetPack.h"
+#include "Utils/Logger.h"
+#include <algorithm>
+#include <cstring>
+
+AssetPack::AssetPack() : entries(nullptr), entryCount(0) {
+}
+
+bool AssetPack::open(const std::string& filename) {
+    close();
+
+    if (!file.open(filename)) {
+        return false;
+    }
+
+    using namespace AssetPackFormat;
+    const std::size_t fileSize = file.getSize();
+    if (fileSize < sizeof(Header)) {
+        LOG_ERROR(Assets, "Asset pack too small: %s", filename.c_str());
+        close();
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, file.getData(), sizeof(Header));
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version) {
+        LOG_ERROR(Assets, "Invalid asset pack header: %s", filename.c_str());
+        close();
+        return false;
+    }
+
+    const std::uint64_t indexEnd = header.indexOffset + static_cast<std::uint64_t>(header.entryCount) * sizeof(Entry);
+    if (header.indexOffset % alignof(Entry) != 0 || indexEnd > fileSize) {
+        LOG_ERROR(Assets, "Corrupted asset pack index: %s", filename.c_str());
+        close();
+        return false;
+    }
+
+    entries = reinterpret_cast<const Entry*>(file.getData() + header.indexOffset);
+    entryCount = header.entryCount;
+
+    // 数据块必须完整地落在文件内
+    for (std::uint32_t i = 0; i < entryCount; ++i) {
+        if (entries[i].offset > fileSize || entries[i].size > fileSize - entries[i].offset) {
+            LOG_ERROR(Assets, "Corrupted asset pack entry: %s", filename.c_str());
+            close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void AssetPack::close() {
+    file.close();
+    entries = nullptr;
+    entryCount = 0;
+}
+
+bool AssetPack::isOpen() const {
+    return entries != nullptr;
+}
+
+AssetBlob AssetPack::find(const std::string& path) const {
+    if (!entries || path.size() >= AssetPackFormat::MaxPathLength) {
+        return {};
+    }
+
+    const AssetPackFormat::Entry* end = entries + entryCount;
+    const AssetPackFormat::Entry* it = std::lower_bound(entries, end, path,
+        [](const AssetPackFormat::Entry& entry, const std::string& key) {
+            return std::strncmp(entry.path, key.c_str(), AssetPackFormat::MaxPathLength) < 0;
+        });
+
+    if (it == end || std::strncmp(it->path, path.c_str(), AssetPackFormat::MaxPathLength) != 0) {
+        return {};
+    }
+
+    return {file.getData() + it->offset, static_cast<std::size_t>(it->size)};
+}
+
+std::uint32_t AssetPack::getEntryCount() const {
+    return entryCount;
+}
@@ -0,0 +1,126 @@
+#include "Managers/Autopilot.h"
+#include "Managers/LevelGenerator.h"
+#include <algorithm>
+#include <cmath>
+
+Autopilot::Autopilot(float windowWidth, float skill, float reactionDelay, std::uint64_t seed)
+    : windowWidth(windowWidth),
+      skill(std::clamp(skill, 0.0f, 1.0f)),
+      reactionDelay(std::max(reactionDelay, 0.0f)),
+      trackedBall(nullptr),
+      trackedVelocity(0.0f, 0.0f),
+      reactionTimer(0.0f),
+      target(0.0f),
+      hasTarget(false),
+      aimOffset(0.0f),
+      levelTime(0.0f),
+      rngState(seed) {
+}
+
+void Autopilot::setSkill(float value) {
+    skill = std::clamp(value, 0.0f, 1.0f);
+}
+
+void Autopilot::setReactionDelay(float seconds) {
+    reactionDelay = std::max(seconds, 0.0f);
+}
+
+void Autopilot::reset() {
+    trackedBall = nullptr;
+    trackedVelocity = sf::Vector2f(0.0f, 0.0f);
+    reactionTimer = 0.0f;
+    hasTarget = false;
+    aimOffset = 0.0f;
+    levelTime = 0.0f;
+}
+
+const Ball* Autopilot::pickBall(const std::vector<std::unique_ptr<Ball>>& balls, float paddleTop) {
+    const Ball* lowest = nullptr;
+    const Ball* lowestFalling = nullptr;
+    for (const auto& ball : balls) {
+        if (!ball || !ball->isActive() || ball->getPosition().y > paddleTop) {
+            continue;
+        }
+        if (!lowest || ball->getPosition().y > lowest->getPosition().y) {
+            lowest = ball.get();
+        }
+        if (ball->getVelocity().y > 0.0f &&
+            (!lowestFalling || ball->getPosition().y > lowestFalling->getPosition().y)) {
+            lowestFalling = ball.get();
+        }
+    }
+    return lowestFalling ? lowestFalling : lowest;
+}
+
+float Autopilot::randomFloat(float min, float max) {
+    rngState += 0x9E3779B97F4A7C15ull;
+    return min + (max - min) * LevelGenerator::unitFloat(LevelGenerator::mix(rngState), 0);
+}
+
+void Autopilot::chooseAim(float paddleWidth) {
+    // 故意让球打在离挡板中心最多 30% 宽度的地方，反弹带角度，不会在两点之间竖直来回；
+    // 技术越差误差越大，skill 为 0 时最多再偏 75% 宽度（会漏接）
+    float english = randomFloat(-0.3f, 0.3f);
+    float error = (1.0f - skill) * randomFloat(-0.75f, 0.75f);
+    aimOffset = (english + error) * paddleWidth;
+}
+
+float Autopilot::update(const std::vector<std::unique_ptr<Ball>>& balls, const Paddle& paddle, float deltaTime) {
+    levelTime += deltaTime;
+    
+    const float paddleWidth = paddle.getSize().x;
+    const float paddleTop = paddle.getPosition().y;
+    const float center = paddle.getPosition().x + paddleWidth / 2.0f;
+    
+    if (const Ball* ball = pickBall(balls, paddleTop)) {
+        // 换了球或者球反弹了：过了反应时间才按新的落点移动，在这之前继续去旧的目标
+        const sf::Vector2f velocity = ball->getVelocity();
+        if (ball != trackedBall || velocity != trackedVelocity) {
+            trackedBall = ball;
+            trackedVelocity = velocity;
+            reactionTimer = reactionDelay;
+            chooseAim(paddleWidth);
+        }
+        
+        if (reactionTimer > 0.0f) {
+            reactionTimer -= deltaTime;
+        } else {
+            float landing = predictLanding(ball->getPosition(), velocity, ball->getRadius(), paddleTop, windowWidth);
+            target = std::clamp(landing - aimOffset, paddleWidth / 2.0f, windowWidth - paddleWidth / 2.0f);
+            hasTarget = true;
+        }
+    }
+    
+    // 挡板每帧移动 方向 * 速度 * deltaTime，按剩下的距离算方向，最后一帧不会冲过头；
+    // 方向的上限与键盘相同（PlayState 按住方向键时传入 getMaxSpeed() * deltaTime）
+    const float step = paddle.getSpeed() * deltaTime;
+    if (!hasTarget || step <= 0.0f) {
+        return 0.0f;
+    }
+    const float maxDirection = std::min(1.0f, paddle.getMaxSpeed() * deltaTime);
+    return std::clamp((target - center) / step, -maxDirection, maxDirection);
+}
+
+float Autopilot::predictLanding(const sf::Vector2f& position, const sf::Vector2f& velocity, float radius,
+                                float paddleTop, float windowWidth) {
+    const float centerX = position.x + radius;
+    if (velocity.y <= 0.0f) {
+        return centerX;
+    }
+    
+    // 球心在 [radius, windowWidth - radius] 之间来回反弹：把直线运动的横坐标按周期 2 * span 折回区间内
+    const float time = std::max(paddleTop - (position.y + radius * 2.0f), 0.0f) / velocity.y;
+    const float span = windowWidth - radius * 2.0f;
+    if (span <= 0.0f) {
+        return windowWidth / 2.0f;
+    }
+    
+    float offset = std::fmod(centerX + velocity.x * time - radius, span * 2.0f);
+    if (offset < 0.0f) {
+        offset += span * 2.0f;
+    }
+    if (offset > span) {
+        offset = span * 2.0f - offset;
+    }
+    return radius + offset;
+}
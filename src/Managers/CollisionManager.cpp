@@ -1,19 +1,34 @@
 #include "Managers/CollisionManager.h"
 #include "Managers/AssetManager.h"
+#include "Utils/Tracer.h"
+#include "Utils/FlightRecorder.h"
+#include "Utils/AllocTracker.h"
+#include <utility>
 #include <algorithm>
 #include <cmath>
 
-CollisionManager::CollisionManager() : windowSize(800, 600) {
+CollisionManager::CollisionManager()
+    : windowSize(800, 600),
+      wallSound(AssetManager::getInstance()->findSound("ball_windows"_asset)),
+      pairTests(0),
+      destroyedBricks(FrameArena::getInstance()) {
 }
 
-CollisionManager::CollisionManager(const sf::Vector2u& windowSize) : windowSize(windowSize) {
+CollisionManager::CollisionManager(const sf::Vector2u& windowSize)
+    : windowSize(windowSize),
+      wallSound(AssetManager::getInstance()->findSound("ball_windows"_asset)),
+      pairTests(0),
+      destroyedBricks(FrameArena::getInstance()) {
 }
 
 void CollisionManager::setWindowSize(const sf::Vector2u& size) {
     windowSize = size;
 }
 
-void CollisionManager::update(Ball* ball, Paddle* paddle, std::vector<std::unique_ptr<Brick>>& bricks) {
+void CollisionManager::update(Ball* ball, Paddle* paddle, BrickList& bricks) {
+    TRACE_SCOPE("CollisionManager::update");
+    AllocTracker::TagScope tag(AllocTracker::Collision);
+    beginUpdate();
     if (!ball || !ball->isActive() || !paddle || !paddle->isActive()) {
         return;
     }
@@ -27,16 +42,19 @@ void CollisionManager::update(Ball* ball, Paddle* paddle, std::vector<std::uniqu
     }
     
     // 检测球与砖块的碰撞
-    for (auto& brick : bricks) {
-        if (brick->isActive() && checkEntityCollision(ball, brick.get())) {
-            handleBallBrickCollision(ball, brick.get());
+    for (Brick* brick : bricks) {
+        if (brick->isActive() && checkEntityCollision(ball, brick)) {
+            handleBallBrickCollision(ball, brick);
             break; // 一次只处理一个碰撞，避免多次反弹
         }
     }
 }
 
 // 多球碰撞检测方法
-void CollisionManager::update(std::vector<std::unique_ptr<Ball>>& balls, Paddle* paddle, std::vector<std::unique_ptr<Brick>>& bricks) {
+void CollisionManager::update(std::vector<std::unique_ptr<Ball>>& balls, Paddle* paddle, BrickList& bricks) {
+    TRACE_SCOPE("CollisionManager::update");
+    AllocTracker::TagScope tag(AllocTracker::Collision);
+    beginUpdate();
     if (!paddle || !paddle->isActive() || balls.empty()) {
         return;
     }
@@ -53,9 +71,9 @@ void CollisionManager::update(std::vector<std::unique_ptr<Ball>>& balls, Paddle*
             }
             
             // 检测球与砖块的碰撞
-            for (auto& brick : bricks) {
-                if (brick->isActive() && checkEntityCollision(ball.get(), brick.get())) {
-                    handleBallBrickCollision(ball.get(), brick.get());
+            for (Brick* brick : bricks) {
+                if (brick->isActive() && checkEntityCollision(ball.get(), brick)) {
+                    handleBallBrickCollision(ball.get(), brick);
                     break; // 一次只处理一个碰撞，避免多次反弹
                 }
             }
@@ -63,6 +81,66 @@ void CollisionManager::update(std::vector<std::unique_ptr<Ball>>& balls, Paddle*
     }
 }
 
+// 无尽模式碰撞检测方法
+void CollisionManager::update(std::vector<std::unique_ptr<Ball>>& balls, Paddle* paddle, EndlessField& field) {
+    TRACE_SCOPE("CollisionManager::update");
+    AllocTracker::TagScope tag(AllocTracker::Collision);
+    beginUpdate();
+    if (!paddle || !paddle->isActive() || balls.empty()) {
+        return;
+    }
+    
+    for (auto& ball : balls) {
+        if (ball && ball->isActive()) {
+            checkBallWindowCollision(ball.get());
+            
+            if (checkEntityCollision(ball.get(), paddle)) {
+                handleBallPaddleCollision(ball.get(), paddle);
+            }
+            
+            checkBallFieldCollision(ball.get(), field);
+        }
+    }
+}
+
+void CollisionManager::beginUpdate() {
+    pairTests = 0;
+    
+    // 上一帧的内存已经随 reset 失效，换一个新的空容器（分配器相同，移动赋值不分配）
+    destroyedBricks = FrameArena::Vector<Brick*>(FrameArena::getInstance());
+}
+
+void CollisionManager::checkBallFieldCollision(Ball* ball, EndlessField& field) {
+    sf::FloatRect ballBounds = ball->getBounds();
+    float ballTop = ballBounds.position.y;
+    float ballBottom = ballTop + ballBounds.size.y;
+    
+    for (int slot = 0; slot < field.getSlotCount(); ++slot) {
+        if (field.isRowEmpty(slot)) continue;
+        
+        // 整行在竖直方向不重叠时直接跳过
+        float rowTop = field.getRowTop(slot);
+        if (ballBottom < rowTop || ballTop > rowTop + field.getRowHeight()) continue;
+        
+        // 把球移到行内坐标，与未平移的砖块比较
+        float offsetY = field.getRowOffset(slot);
+        sf::FloatRect localBall = ballBounds;
+        localBall.position.y -= offsetY;
+        
+        for (int col = 0; col < field.getColumns(); ++col) {
+            Brick* brick = field.getBrick(slot, col);
+            ++pairTests;
+            if (brick->isActive() && localBall.findIntersection(brick->getBounds()).has_value()) {
+                handleBallBrickCollision(ball, brick, offsetY);
+                if (!brick->isActive()) {
+                    field.onBrickDestroyed(slot);
+                }
+                return; // 一次只处理一个碰撞，避免多次反弹
+            }
+        }
+    }
+}
+
 void CollisionManager::checkBallWindowCollision(Ball* ball) {
     sf::Vector2f pos = ball->getPosition();
     sf::Vector2f vel = ball->getVelocity();
@@ -73,12 +151,12 @@ void CollisionManager::checkBallWindowCollision(Ball* ball) {
         ball->setPosition({radius, pos.y});
         ball->reverseX();
         // 播放球碰撞窗口的音效
-        AssetManager::getInstance()->playSound("ball_windows");
+        AssetManager::getInstance()->playSound(wallSound);
     } else if (pos.x + radius * 2 >= windowSize.x) {
         ball->setPosition({windowSize.x - radius * 2, pos.y});
         ball->reverseX();
         // 播放球碰撞窗口的音效
-        AssetManager::getInstance()->playSound("ball_windows");
+        AssetManager::getInstance()->playSound(wallSound);
     }
     
     // 上边界碰撞
@@ -86,10 +164,14 @@ void CollisionManager::checkBallWindowCollision(Ball* ball) {
         ball->setPosition({pos.x, 0});
         ball->reverseY();
         // 播放球碰撞窗口的音效
-        AssetManager::getInstance()->playSound("ball_windows");
+        AssetManager::getInstance()->playSound(wallSound);
     }
     
     // 注意：下边界不反弹，这是游戏失败的条件
+    
+    if (pos.x <= 0 || pos.x + radius * 2 >= windowSize.x || pos.y <= 0) {
+        FlightRecorder::getInstance()->record(FlightRecorder::BallWall, static_cast<int>(pos.x), static_cast<int>(pos.y));
+    }
 }
 
 bool CollisionManager::checkEntityCollision(Entity* a, Entity* b) {
@@ -97,24 +179,22 @@ bool CollisionManager::checkEntityCollision(Entity* a, Entity* b) {
         return false;
     }
     
+    ++pairTests;
     auto intersection = a->getBounds().findIntersection(b->getBounds());
     return intersection.has_value();
 }
 
-void CollisionManager::setOnBrickHitCallback(std::function<void(Brick*)> callback) {
-    onBrickHitCallback = callback;
-}
-
 void CollisionManager::setOnBallPaddleCollisionCallback(std::function<void()> callback) {
-    onBallPaddleCollisionCallback = callback;
+    onBallPaddleCollisionCallback = std::move(callback);
 }
 
-void CollisionManager::handleBallBrickCollision(Ball* ball, Brick* brick) {
+void CollisionManager::handleBallBrickCollision(Ball* ball, Brick* brick, float offsetY) {
     if (!ball || !brick) return;
     
     // 获取球和砖块的位置和大小
     sf::FloatRect ballBounds = ball->getBounds();
     sf::FloatRect brickBounds = brick->getBounds();
+    brickBounds.position.y += offsetY;
     
     // 计算碰撞深度
     float overlapLeft = ballBounds.position.x + ballBounds.size.x - brickBounds.position.x;
@@ -137,13 +217,14 @@ void CollisionManager::handleBallBrickCollision(Ball* ball, Brick* brick) {
     
     // 通知砖块被击中
     brick->onCollision(ball);
+    FlightRecorder::getInstance()->record(FlightRecorder::BallBrick, brick->getHitPoints());
     
     // 通知球碰撞到了砖块
     ball->onCollision(brick);
     
-    // 调用回调函数
-    if (onBrickHitCallback && !brick->isActive()) {
-        onBrickHitCallback(brick);
+    // 击碎的砖块先记下来，遍历球的过程中不回调（回调可能往球列表里加球）
+    if (!brick->isActive()) {
+        destroyedBricks.push_back(brick);
     }
 }
 
@@ -183,6 +264,7 @@ void CollisionManager::handleBallPaddleCollision(Ball* ball, Paddle* paddle) {
         // 通知实体发生了碰撞
         ball->onCollision(paddle);
         paddle->onCollision(ball);
+        FlightRecorder::getInstance()->record(FlightRecorder::BallPaddle, static_cast<int>(ballPos.x));
         
         // 调用回调函数
         if (onBallPaddleCollisionCallback) {
@@ -0,0 +1,173 @@
+#include "Managers/EndlessField.h"
+#include <algorithm>
+
+EndlessField::EndlessField()
+    : columns(0),
+      baseY(0.0f),
+      topY(0.0f),
+      dangerY(0.0f),
+      rowHeight(0.0f),
+      rowPitch(1.0f),
+      scrollSpeed(0.0f),
+      scroll(0.0f),
+      nextGeneration(0) {
+}
+
+void EndlessField::init(BrickList rowBricks, int columnCount, float originY,
+                        float height, float pitch, float danger,
+                        const LevelGenerator::Params& generatorParams, float speed, int initialRows) {
+    bricks = std::move(rowBricks);
+    columns = std::max(columnCount, 1);
+    baseY = originY;
+    topY = originY;
+    dangerY = danger;
+    rowHeight = height;
+    rowPitch = std::max(pitch, 1.0f);
+    scrollSpeed = speed;
+    scroll = 0.0f;
+    nextGeneration = 0;
+
+    params = generatorParams;
+    params.rows = 1;
+    params.columns = columns;
+    params.symmetry = LevelGenerator::Symmetry::None;
+    rowRecords.reserve(static_cast<std::size_t>(columns));
+
+    rows.assign(bricks.size() / static_cast<std::size_t>(columns), Row{});
+    for (Brick* brick : bricks) {
+        brick->setActive(false);
+    }
+
+    // 先铺满开局的几行：最早生成的在最下面
+    const int prefill = std::min(initialRows, static_cast<int>(rows.size()) - 1);
+    for (int i = 0; i < prefill; ++i) {
+        spawnRow();
+    }
+}
+
+void EndlessField::spawnRow() {
+    if (rows.empty()) return;
+
+    const std::uint64_t generation = nextGeneration++;
+    const int slot = static_cast<int>(generation % rows.size());
+    Row& row = rows[slot];
+    row.generation = generation;
+    row.alive = 0;
+
+    // 每行的种子由基础种子和行号决定，同一局的第N行总是相同
+    LevelGenerator::Params rowParams = params;
+    rowParams.seed = LevelGenerator::mix(params.seed ^ generation);
+    LevelGenerator::generate(rowParams, rowRecords);
+
+    static const sf::Color typeColors[] = {sf::Color::Blue, sf::Color::Red, sf::Color::Yellow, sf::Color::Green};
+
+    for (int col = 0; col < columns; ++col) {
+        getBrick(slot, col)->setActive(false);
+    }
+    for (const auto& record : rowRecords) {
+        Brick* brick = getBrick(slot, record.column);
+        brick->setHitPoints(record.hitPoints);
+        brick->setScore(static_cast<int>(record.score));
+        brick->setColor(typeColors[record.type < 4 ? record.type : 0]);
+        brick->setActive(true);
+        ++row.alive;
+    }
+}
+
+int EndlessField::update(float deltaTime) {
+    if (rows.empty()) return 0;
+
+    int breached = 0;
+    scroll += scrollSpeed * deltaTime;
+    while (scroll >= rowPitch) {
+        scroll -= rowPitch;
+
+        // 槽位按代数轮转，新行会覆盖最旧的一行；卡顿或下移很快时一帧会生成好几行，
+        // 最旧的一行可能还没来得及在下面的检查中失守，覆盖前先按失守处理
+        const int oldest = static_cast<int>(nextGeneration % rows.size());
+        if (rows[oldest].alive > 0) {
+            clearRow(oldest);
+            ++breached;
+        }
+        spawnRow();
+    }
+
+    for (int slot = 0; slot < static_cast<int>(rows.size()); ++slot) {
+        if (rows[slot].alive > 0 && getRowTop(slot) + rowHeight >= dangerY) {
+            // 失守的行直接清空，等待回收
+            clearRow(slot);
+            ++breached;
+        }
+    }
+    return breached;
+}
+
+void EndlessField::clearRow(int slot) {
+    for (int col = 0; col < columns; ++col) {
+        getBrick(slot, col)->setActive(false);
+    }
+    rows[slot].alive = 0;
+}
+
+void EndlessField::render(sf::RenderWindow& window) {
+    for (int slot = 0; slot < static_cast<int>(rows.size()); ++slot) {
+        if (rows[slot].alive == 0) continue;
+
+        sf::RenderStates states;
+        states.transform.translate({0.0f, getRowOffset(slot)});
+        for (int col = 0; col < columns; ++col) {
+            Brick* brick = getBrick(slot, col);
+            if (brick->isActive()) {
+                brick->renderTransformed(window, states);
+            }
+        }
+    }
+}
+
+int EndlessField::getSlotCount() const {
+    return static_cast<int>(rows.size());
+}
+
+int EndlessField::getColumns() const {
+    return columns;
+}
+
+bool EndlessField::isRowEmpty(int slot) const {
+    return rows[slot].alive == 0;
+}
+
+float EndlessField::getRowTop(int slot) const {
+    // 与最新一行的代数差不超过槽位数，用整数相减避免长时间运行后的浮点误差
+    const std::uint64_t age = nextGeneration - 1 - rows[slot].generation;
+    return topY + scroll + static_cast<float>(age) * rowPitch;
+}
+
+float EndlessField::getRowOffset(int slot) const {
+    return getRowTop(slot) - baseY;
+}
+
+float EndlessField::getRowHeight() const {
+    return rowHeight;
+}
+
+Brick* EndlessField::getBrick(int slot, int column) const {
+    return bricks[static_cast<std::size_t>(slot) * columns + column];
+}
+
+void EndlessField::onBrickDestroyed(int slot) {
+    if (rows[slot].alive > 0) {
+        --rows[slot].alive;
+    }
+}
+
+int EndlessField::getBrickCount() const {
+    int count = 0;
+    for (const auto& row : rows) {
+        count += row.alive;
+    }
+    return count;
+}
+
+bool EndlessField::isActive() const {
+    return !rows.empty();
+}
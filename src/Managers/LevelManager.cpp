@@ -1,189 +1,290 @@
 #include "Managers/LevelManager.h"
 #include "Managers/AssetManager.h"
+#include "Managers/LevelParser.h"
 #include "Utils/Config.h"
-#include <iostream>
-#include <fstream>
+#include "Utils/MappedFile.h"
+#include "Utils/Tracer.h"
+#include "Utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
 
 LevelManager::LevelManager() 
-    : currentLevel(1), totalLevels(3) {
-    // Get rows and columns from config
-    rows = Config::getInstance().getValue("game.brick_rows", 8);
-    columns = Config::getInstance().getValue("game.brick_columns", 10);
-    
+    : currentLevel(1), totalLevels(3), prefetchedLevel(-1), prefetchCancelled(false) {
     brickSize = sf::Vector2f(80.0f, 30.0f);
     brickPadding = sf::Vector2f(2.0f, 2.0f);
     levelPosition = sf::Vector2f(50.0f, 100.0f);
     levelSize = sf::Vector2f(800.0f, 240.0f);
 }
 
+LevelManager::~LevelManager() {
+    cancelPrefetch();
+}
+
 void LevelManager::init(const std::vector<std::string>& levelFiles, 
                        const sf::Vector2f& levelPos, 
                        const sf::Vector2f& levelSize) {
+    cancelPrefetch();
     this->levelFiles = levelFiles;
     this->levelPosition = levelPos;
     this->levelSize = levelSize;
     this->totalLevels = static_cast<int>(levelFiles.size());
 }
 
-std::vector<std::unique_ptr<Brick>> LevelManager::loadLevel(int levelNumber) {
-    std::vector<std::unique_ptr<Brick>> bricks;
+BrickList LevelManager::loadLevel(int levelNumber) {
+    TRACE_SCOPE("LevelManager::loadLevel");
+    BrickList bricks;
     
     if (levelNumber < 0 || levelNumber >= totalLevels) {
-        std::cerr << "Invalid level number: " << levelNumber << std::endl;
+        LOG_ERROR(Levels, "Invalid level number: %d", levelNumber);
         return bricks;
     }
     
-    std::string filename = "resources/levels/level" + std::to_string(levelNumber + 1) + ".txt";
-    std::ifstream file(filename);
-    
-    if (!file.is_open()) {
-        std::cerr << "Cannot open level file: " << filename << std::endl;
-        return bricks;
+    if (prefetched.valid() && prefetchedLevel == levelNumber) {
+        // 预取命中：工作线程已经构建好了砖块，这里只是交换
+        TRACE_INSTANT("level prefetch hit");
+        bricks = prefetched.get();
+        prefetchedLevel = -1;
+    } else {
+        bricks = buildLevel(levelNumber);
     }
     
-    std::string line;
-    int row = 0;
+    currentLevel = levelNumber;
+    LOG_INFO(Levels, "Level %d loaded, brick count: %zu", levelNumber + 1, bricks.size());
     
-    // 计算实际可用宽度，确保砖块不会超出屏幕
-    float totalAvailableWidth = levelSize.x;
-    float actualBrickWidth = (totalAvailableWidth - (columns - 1) * brickPadding.x) / columns;
+    // 关卡一开始就在后台准备下一关
+    if (hasNextLevel()) {
+        prefetch(currentLevel + 1);
+    }
+    return bricks;
+}
+
+BrickList LevelManager::buildLevel(int levelNumber, const std::atomic<bool>* cancel) const {
+    BrickList bricks;
+    const std::string& filename = levelFiles[levelNumber];
+    TRACE_SCOPE_DETAIL("LevelManager::buildLevel", filename.c_str());
+    
+    // 优先使用编译后的二进制关卡，文本关卡作为回退
+    if (!loadCompiledLevel(LevelFormat::compiledPath(filename), bricks, cancel)) {
+        loadTextLevel(filename, bricks, cancel);
+    }
+    return bricks;
+}
+
+void LevelManager::prefetch(int levelNumber) {
+    if (levelNumber < 0 || levelNumber >= totalLevels) {
+        return;
+    }
+    if (prefetched.valid() && prefetchedLevel == levelNumber) {
+        return;
+    }
     
-    while (std::getline(file, line) && row < rows) {
-        for (size_t col = 0; col < line.length() && col < static_cast<size_t>(columns); ++col) {
-            char brickType = line[col];
-            if (brickType != ' ') {
-                // Create brick with adjusted size to fit screen
-                auto brick = std::make_unique<Brick>();
-                brick->setPosition(sf::Vector2f(
-                    levelPosition.x + col * (actualBrickWidth + brickPadding.x),
-                    levelPosition.y + row * (brickSize.y + brickPadding.y)
-                ));
-                brick->setSize(sf::Vector2f(actualBrickWidth, brickSize.y));
-                
-                // Set brick properties based on character
-                switch (brickType) {
-                    case '1':
-                        brick->setHitPoints(1);
-                        brick->setColor(sf::Color::Red);
-                        break;
-                    case '2':
-                        brick->setHitPoints(2);
-                        brick->setColor(sf::Color::Yellow);
-                        break;
-                    case '3':
-                        brick->setHitPoints(3);
-                        brick->setColor(sf::Color::Green);
-                        break;
-                    default:
-                        brick->setHitPoints(1);
-                        brick->setColor(sf::Color::Blue);
-                        break;
-                }
-                
-                // Set brick texture
-                if (AssetManager::getInstance()->hasTexture("brick")) {
-                    brick->setTexture(AssetManager::getInstance()->getTexture("brick"));
-                }
-                
-                bricks.push_back(std::move(brick));
-            }
+    cancelPrefetch();
+    prefetchedLevel = levelNumber;
+    prefetched = std::async(std::launch::async, [this, levelNumber]() {
+        TRACE_THREAD_NAME("level-prefetch");
+        return buildLevel(levelNumber, &prefetchCancelled);
+    });
+}
+
+void LevelManager::cancelPrefetch() {
+    if (prefetched.valid()) {
+        // 通知工作线程提前结束，然后丢弃结果
+        prefetchCancelled = true;
+        prefetched.wait();
+        prefetched = {};
+        prefetchCancelled = false;
+    }
+    prefetchedLevel = -1;
+}
+
+bool LevelManager::isPrefetchReady() const {
+    return prefetched.valid() &&
+           prefetched.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+bool LevelManager::loadTextLevel(const std::string& filename, BrickList& bricks,
+                                 const std::atomic<bool>* cancel) const {
+    // 与二进制关卡一样直接解析映射内存，不经过iostream
+    MappedFile mapped;
+    AssetBlob blob = AssetManager::getInstance()->findPacked(filename);
+    if (!blob) {
+        if (!mapped.open(filename)) {
+            LOG_ERROR(Levels, "Cannot open level file: %s", filename.c_str());
+            return false;
         }
-        row++;
+        blob = {mapped.getData(), mapped.getSize()};
     }
     
-    file.close();
-    currentLevel = levelNumber;
-    std::cout << "Level " << levelNumber + 1 << " loaded successfully, brick count: " << bricks.size() << std::endl;
-    return bricks;
+    LevelParser::Layout layout;
+    LevelParser::Error error;
+    if (!LevelParser::parse(static_cast<const char*>(blob.data), blob.size, layout, error)) {
+        LOG_ERROR(Levels, "%s:%d:%d: %s", filename.c_str(), error.line, error.column, error.message.c_str());
+        return false;
+    }
+    if (layout.records.empty()) {
+        LOG_ERROR(Levels, "Level has no bricks: %s", filename.c_str());
+        return false;
+    }
+    
+    buildBricks(layout.records.data(), layout.records.size(), layout.columns, layout.rows, bricks, false, cancel);
+    return true;
 }
 
-bool LevelManager::loadLevel(int levelNumber, std::vector<std::unique_ptr<Brick>>& bricks) {
-    if (levelNumber < 1 || levelNumber > totalLevels) {
-        std::cerr << "Invalid level number: " << levelNumber << std::endl;
+bool LevelManager::loadCompiledLevel(const std::string& filename, BrickList& bricks,
+                                     const std::atomic<bool>* cancel) const {
+    // 资源包中的关卡直接使用包的映射，否则单独映射关卡文件
+    MappedFile mapped;
+    AssetBlob blob = AssetManager::getInstance()->findPacked(filename);
+    if (!blob) {
+        if (!mapped.open(filename)) {
+            return false;
+        }
+        blob = {mapped.getData(), mapped.getSize()};
+    }
+    
+    const auto* data = static_cast<const unsigned char*>(blob.data);
+    LevelFormat::Header header;
+    if (blob.size < sizeof(header)) {
+        LOG_ERROR(Levels, "Compiled level too small: %s", filename.c_str());
         return false;
     }
+    std::memcpy(&header, data, sizeof(header));
     
-    std::string filename = "resources/levels/level" + std::to_string(levelNumber) + ".txt";
-    std::ifstream file(filename);
+    if (std::memcmp(header.magic, LevelFormat::Magic, sizeof(LevelFormat::Magic)) != 0 ||
+        header.version != LevelFormat::Version) {
+        LOG_ERROR(Levels, "Unsupported compiled level: %s", filename.c_str());
+        return false;
+    }
     
-    if (!file.is_open()) {
-        std::cerr << "Cannot open level file: " << filename << std::endl;
+    const std::uint64_t recordsEnd = header.recordOffset +
+        static_cast<std::uint64_t>(header.brickCount) * sizeof(LevelFormat::BrickRecord);
+    if (header.recordOffset % alignof(LevelFormat::BrickRecord) != 0 || recordsEnd > blob.size ||
+        header.rows == 0 || header.columns == 0) {
+        LOG_ERROR(Levels, "Corrupted compiled level: %s", filename.c_str());
         return false;
     }
     
-    // Clear existing bricks
-    bricks.clear();
+    // 记录直接从映射内存读取，不做中间拷贝
+    const auto* records = reinterpret_cast<const LevelFormat::BrickRecord*>(data + header.recordOffset);
+    buildBricks(records, header.brickCount, header.columns, header.rows, bricks, false, cancel);
+    return true;
+}
+
+void LevelManager::buildBricks(const LevelFormat::BrickRecord* records, std::size_t count, int gridColumns, int gridRows,
+                               BrickList& bricks, bool fitToArea,
+                               const std::atomic<bool>* cancel) const {
+    bricks.reserve(bricks.size() + count);
     
-    std::string line;
-    int row = 0;
-    float startX = levelPosition.x;
-    float startY = levelPosition.y;
+    sf::Vector2f padding = brickPadding;
+    float brickHeight = brickSize.y;
+    if (fitToArea) {
+        // 网格很密时去掉间距，高度按行数压缩到关卡区域内
+        if (gridColumns * padding.x * 2.0f > levelSize.x) padding.x = 0.0f;
+        if (gridRows * padding.y * 2.0f > levelSize.y) padding.y = 0.0f;
+        brickHeight = std::min(brickHeight, (levelSize.y - (gridRows - 1) * padding.y) / gridRows);
+    }
     
     // 计算实际可用宽度，确保砖块不会超出屏幕
-    float totalAvailableWidth = levelSize.x;
-    float actualBrickWidth = (totalAvailableWidth - (columns - 1) * brickPadding.x) / columns;
+    float actualBrickWidth = (levelSize.x - (gridColumns - 1) * padding.x) / gridColumns;
+    sf::Vector2f actualBrickSize(actualBrickWidth, brickHeight);
     
-    while (std::getline(file, line) && row < rows) {
-        for (size_t col = 0; col < line.length() && col < static_cast<size_t>(columns); ++col) {
-            char brickType = line[col];
-            if (brickType != ' ') {
-                // Create brick with adjusted size
-                auto brick = std::make_unique<Brick>();
-                brick->setPosition(sf::Vector2f(
-                    startX + col * (actualBrickWidth + brickPadding.x),
-                    startY + row * (brickSize.y + brickPadding.y)
-                ));
-                brick->setSize(sf::Vector2f(actualBrickWidth - brickPadding.x, brickSize.y - brickPadding.y));
-                
-                // Set brick properties based on character
-                switch (brickType) {
-                    case '1':
-                        brick->setHitPoints(1);
-                        brick->setColor(sf::Color::Red);
-                        break;
-                    case '2':
-                        brick->setHitPoints(2);
-                        brick->setColor(sf::Color::Yellow);
-                        break;
-                    case '3':
-                        brick->setHitPoints(3);
-                        brick->setColor(sf::Color::Green);
-                        break;
-                    default:
-                        brick->setHitPoints(1);
-                        brick->setColor(sf::Color::Blue);
-                        break;
-                }
-                
-                // Set brick texture
-                if (AssetManager::getInstance()->hasTexture("brick")) {
-                    brick->setTexture(AssetManager::getInstance()->getTexture("brick"));
-                }
-                
-                bricks.push_back(std::move(brick));
-            }
-        }
-        row++;
+    // 砖块纹理只解析一次
+    const sf::Texture* texture = nullptr;
+    TextureHandle brickTexture = AssetManager::getInstance()->findTexture("brick"_asset);
+    if (brickTexture.isValid()) {
+        texture = &AssetManager::getInstance()->getTexture(brickTexture);
     }
     
-    file.close();
-    std::cout << "Level " << levelNumber << " loaded successfully, brick count: " << bricks.size() << std::endl;
-    return true;
+    // 按类型查表取颜色
+    static const sf::Color typeColors[] = {sf::Color::Blue, sf::Color::Red, sf::Color::Yellow, sf::Color::Green};
+    
+    for (std::size_t i = 0; i < count; ++i) {
+        // 预取被取消时尽快退出
+        if (cancel && (i & 1023) == 0 && cancel->load(std::memory_order_relaxed)) {
+            return;
+        }
+        
+        const LevelFormat::BrickRecord& record = records[i];
+        if (record.row >= gridRows || record.column >= gridColumns) {
+            continue;
+        }
+        
+        // 砖块放在关卡的分配器里，换关时一次释放
+        Brick* brick = bricks.create(
+            sf::Vector2f(
+                levelPosition.x + record.column * (actualBrickWidth + padding.x),
+                levelPosition.y + record.row * (brickHeight + padding.y)
+            ),
+            actualBrickSize,
+            record.hitPoints,
+            static_cast<int>(record.score)
+        );
+        brick->setColor(typeColors[record.type < 4 ? record.type : 0]);
+        
+        if (texture) {
+            brick->setTexture(*texture);
+        }
+    }
 }
 
-std::vector<std::unique_ptr<Brick>> LevelManager::loadNextLevel() {
+BrickList LevelManager::loadNextLevel() {
     if (hasNextLevel()) {
         return loadLevel(currentLevel + 1);
     }
     
-    std::cerr << "Warning: No more levels" << std::endl;
+    LOG_WARN(Levels, "No more levels");
     return {};
 }
 
-std::vector<std::unique_ptr<Brick>> LevelManager::reloadCurrentLevel() {
+BrickList LevelManager::reloadCurrentLevel() {
     return loadLevel(currentLevel);
 }
 
+BrickList LevelManager::generateLevel(const LevelGenerator::Params& params) const {
+    std::vector<LevelFormat::BrickRecord> records;
+    LevelGenerator::generate(params, records);
+    
+    int gridRows = std::clamp(params.rows, 1, LevelGenerator::MaxDimension);
+    int gridColumns = std::clamp(params.columns, 1, LevelGenerator::MaxDimension);
+    
+    BrickList bricks;
+    buildBricks(records.data(), records.size(), gridColumns, gridRows, bricks, true);
+    
+    LOG_INFO(Levels, "Generated level (seed %llu, %dx%d), brick count: %zu",
+             static_cast<unsigned long long>(params.seed), gridRows, gridColumns, bricks.size());
+    return bricks;
+}
+
+void LevelManager::initEndless(EndlessField& field, std::uint64_t seed, float dangerY) const {
+    const GameSettings& settings = Config::getInstance().getSettings();
+    int gridColumns = std::clamp(settings.endlessColumns, 1, LevelGenerator::MaxDimension);
+    
+    // 环形缓冲区刚好覆盖从顶部到失守线的所有行，再多一行给正在进入的新行
+    float rowPitch = brickSize.y + brickPadding.y;
+    int slotCount = static_cast<int>(std::ceil((dangerY - levelPosition.y) / rowPitch)) + 1;
+    slotCount = std::max(slotCount, 2);
+    
+    // 所有槽位的砖块都建在第0行，行偏移在渲染和碰撞时再加上
+    std::vector<LevelFormat::BrickRecord> records(static_cast<std::size_t>(slotCount) * gridColumns);
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        records[i] = {static_cast<std::uint16_t>(i % gridColumns), 0, 0, 1, 0, 100};
+    }
+    BrickList bricks;
+    buildBricks(records.data(), records.size(), gridColumns, 1, bricks);
+    
+    LevelGenerator::Params params;
+    params.seed = seed;
+    params.density = std::clamp(settings.endlessDensity, 0, 100) / 100.0f;
+    
+    field.init(std::move(bricks), gridColumns, levelPosition.y, brickSize.y, rowPitch, dangerY, params,
+               settings.endlessScrollSpeed, settings.endlessStartRows);
+    
+    LOG_INFO(Levels, "Endless mode started (seed %llu, %d rows x %d columns)",
+             static_cast<unsigned long long>(seed), slotCount, gridColumns);
+}
+
 int LevelManager::getCurrentLevel() const {
     return currentLevel;
 }
@@ -197,91 +298,11 @@ bool LevelManager::hasNextLevel() const {
 }
 
 void LevelManager::setBrickSize(const sf::Vector2f& size) {
+    cancelPrefetch();
     brickSize = size;
 }
 
 void LevelManager::setBrickPadding(const sf::Vector2f& padding) {
+    cancelPrefetch();
     brickPadding = padding;
 }
-
-std::vector<std::unique_ptr<Brick>> LevelManager::loadLevelFromFile(const std::string& filename) {
-    std::vector<std::unique_ptr<Brick>> bricks;
-    std::ifstream file(filename);
-    
-    if (!file.is_open()) {
-        std::cerr << "Cannot open level file: " << filename << std::endl;
-        return bricks;
-    }
-    
-    // 读取关卡尺寸
-    file >> rows >> columns;
-    
-    if (rows <= 0 || columns <= 0) {
-        std::cerr << "Invalid level size: " << rows << "x" << columns << std::endl;
-        return bricks;
-    }
-    
-    // Calculate actual brick size, considering level area size and brick spacing
-    float availableWidth = levelSize.x;
-    float availableHeight = levelSize.y;
-    
-    sf::Vector2f actualBrickSize(
-        (availableWidth - (columns - 1) * brickPadding.x) / columns,
-        (availableHeight - (rows - 1) * brickPadding.y) / rows
-    );
-    
-    // Read level data
-    int brickType;
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < columns; ++j) {
-            if (file >> brickType) {
-                    // Only create brick when brick type is greater than 0
-                    sf::Vector2f position(
-                        levelPosition.x + j * (actualBrickSize.x + brickPadding.x),
-                        levelPosition.y + i * (actualBrickSize.y + brickPadding.y)
-                    );
-                    
-                    // Create brick
-                    auto brick = std::make_unique<Brick>();
-                    brick->setPosition(position);
-                    brick->setSize(actualBrickSize);
-                    
-                    // Set brick properties based on brick type
-                    switch (brickType) {
-                        case 1:
-                            brick->setColor(sf::Color::Red);
-                            brick->setScore(100);
-                            break;
-                        case 2:
-                            brick->setColor(sf::Color::Yellow);
-                            brick->setScore(200);
-                            break;
-                        case 3:
-                            brick->setColor(sf::Color::Green);
-                            brick->setScore(300);
-                            break;
-                        case 4:
-                            brick->setColor(sf::Color::Blue);
-                            brick->setScore(400);
-                            break;
-                        case 5:
-                            brick->setColor(sf::Color(128, 0, 128)); // 紫色
-                            brick->setScore(500);
-                            break;
-                        default:
-                            continue; // Skip this brick
-                    }
-                    
-                    // Set brick texture
-                    if (AssetManager::getInstance()->hasTexture("brick")) {
-                        brick->setTexture(AssetManager::getInstance()->getTexture("brick"));
-                    }
-                    
-                    bricks.push_back(std::move(brick));
-            }
-        }
-    }
-    
-    file.close();
-    return bricks;
-}
\ No newline at end of file
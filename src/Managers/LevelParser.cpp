@@ -0,0 +1,171 @@
+#include "Managers/LevelParser.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+    enum CellKind : std::uint8_t {
+        Invalid,
+        Empty,
+        Filled
+    };
+
+    struct Cell {
+        std::uint8_t kind;
+        std::uint8_t type;
+        std::uint8_t hitPoints;
+    };
+
+    // 字符到格子的查找表，解析时不再按字符分支
+    constexpr std::array<Cell, 256> makeCellTable() {
+        std::array<Cell, 256> table{};
+        for (auto& cell : table) {
+            cell = {Invalid, 0, 0};
+        }
+        table[' '] = table['.'] = table['0'] = table['\t'] = table['\r'] = {Empty, 0, 0};
+        table['1'] = {Filled, 1, 1};
+        table['2'] = {Filled, 2, 2};
+        table['3'] = {Filled, 3, 3};
+        table['x'] = table['X'] = {Filled, 0, 1};
+        return table;
+    }
+
+    constexpr std::array<Cell, 256> CellTable = makeCellTable();
+
+    constexpr std::uint32_t BrickScore = 100;
+
+    bool fail(LevelParser::Error& error, int line, int column, const char* message) {
+        error.line = line;
+        error.column = column;
+        error.message = message;
+        return false;
+    }
+
+    // 解析非负整数，p 前进到数字之后
+    bool parseNumber(const char*& p, const char* end, int& value) {
+        while (p < end && (*p == ' ' || *p == '\t')) ++p;
+        if (p == end || *p < '0' || *p > '9') {
+            return false;
+        }
+        value = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            value = value * 10 + (*p - '0');
+            if (value > LevelFormat::MaxDimension) {
+                return false;
+            }
+            ++p;
+        }
+        return true;
+    }
+}
+
+bool LevelParser::parse(const char* data, std::size_t size, Layout& layout, Error& error) {
+    const char* p = data;
+    const char* const end = data + size;
+
+    int headerRows = 0;
+    int headerColumns = 0;
+    bool haveHeader = false;
+    bool inGrid = false;
+
+    int lineNumber = 0;
+    int row = 0;
+    int rows = 0;
+    int columns = 0;
+    std::size_t count = 0;
+
+    auto& records = layout.records;
+    records.clear();
+
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        if (!lineEnd) lineEnd = end;
+        const char* next = lineEnd < end ? lineEnd + 1 : end;
+        if (lineEnd > p && lineEnd[-1] == '\r') --lineEnd;
+        ++lineNumber;
+
+        const int length = static_cast<int>(lineEnd - p);
+
+        if (length > 0 && *p == '#') {
+            p = next;
+            continue;
+        }
+
+        if (!inGrid && length >= 4 && std::memcmp(p, "size", 4) == 0) {
+            const char* q = p + 4;
+            if (!parseNumber(q, lineEnd, headerRows) || !parseNumber(q, lineEnd, headerColumns) ||
+                headerRows == 0 || headerColumns == 0) {
+                return fail(error, lineNumber, static_cast<int>(q - p) + 1, "expected 'size <rows> <columns>'");
+            }
+            while (q < lineEnd && (*q == ' ' || *q == '\t')) ++q;
+            if (q != lineEnd) {
+                return fail(error, lineNumber, static_cast<int>(q - p) + 1, "unexpected text after size header");
+            }
+            haveHeader = true;
+            p = next;
+            continue;
+        }
+
+        if (!inGrid) {
+            // 第一行网格：一次性分配，之后不再增长
+            // 每个实心格子至少占一个输入字节，头部声明的大小再大也不超过剩余的缓冲区
+            // 多留一个位置给最后一个空格子的无条件写入
+            inGrid = true;
+            std::size_t capacity = static_cast<std::size_t>(end - p);
+            if (haveHeader) {
+                capacity = std::min(capacity, static_cast<std::size_t>(headerRows) * headerColumns);
+            }
+            records.resize(capacity + 1);
+        }
+
+        if (haveHeader && row >= headerRows && length > 0) {
+            return fail(error, lineNumber, 1, "more rows than the size header");
+        }
+        if (haveHeader && length > headerColumns) {
+            return fail(error, lineNumber, headerColumns + 1, "row is wider than the size header");
+        }
+        if (length > LevelFormat::MaxDimension) {
+            return fail(error, lineNumber, LevelFormat::MaxDimension + 1, "row is too wide");
+        }
+
+        bool rowHasBrick = false;
+        for (int col = 0; col < length; ++col) {
+            const Cell cell = CellTable[static_cast<unsigned char>(p[col])];
+            if (cell.kind == Invalid) {
+                return fail(error, lineNumber, col + 1, "unknown brick character");
+            }
+
+            // 无条件写入，只有实心格子才前进
+            LevelFormat::BrickRecord& record = records[count];
+            record.column = static_cast<std::uint16_t>(col);
+            record.row = static_cast<std::uint16_t>(row);
+            record.type = cell.type;
+            record.hitPoints = cell.hitPoints;
+            record.reserved = 0;
+            record.score = BrickScore;
+
+            const bool filled = cell.kind == Filled;
+            count += filled;
+            rowHasBrick |= filled;
+        }
+
+        if (rowHasBrick) {
+            rows = row + 1;
+        }
+        if (length > columns) {
+            columns = length;
+        }
+
+        ++row;
+        if (row > LevelFormat::MaxDimension) {
+            return fail(error, lineNumber, 1, "too many rows");
+        }
+        p = next;
+    }
+
+    records.resize(count);
+    layout.rows = haveHeader ? headerRows : rows;
+    layout.columns = haveHeader ? headerColumns : columns;
+    return true;
+}
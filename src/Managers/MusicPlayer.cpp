@@ -0,0 +1,125 @@
+#include "Managers/MusicPlayer.h"
+#include "Utils/Logger.h"
+#include <algorithm>
+
+// Static member initialization
+MusicPlayer* MusicPlayer::s_instance = nullptr;
+
+MusicPlayer::MusicPlayer()
+    : current(-1),
+      musicVolume(80.0f),
+      enabled(true),
+      bufferMilliseconds(250),
+      bufferChunks(3) {
+}
+
+MusicPlayer::~MusicPlayer() {
+    for (auto& deck : decks) {
+        deck.stream.stop();
+    }
+}
+
+MusicPlayer* MusicPlayer::getInstance() {
+    if (s_instance == nullptr) {
+        s_instance = new MusicPlayer();
+    }
+    return s_instance;
+}
+
+void MusicPlayer::configure(float volume, bool isEnabled, unsigned int milliseconds, std::size_t chunks) {
+    musicVolume = std::clamp(volume, 0.0f, 100.0f);
+    enabled = isEnabled;
+    bufferMilliseconds = std::max(milliseconds, 10u);
+    bufferChunks = std::max<std::size_t>(chunks, 2);
+
+    if (!enabled) {
+        stop(0.0f);
+    }
+}
+
+bool MusicPlayer::play(const std::string& filename, float fadeSeconds) {
+    if (!enabled) {
+        return false;
+    }
+
+    if (current >= 0 && decks[current].active && decks[current].stream.getFilename() == filename) {
+        // 同一曲目：如果正在淡出则重新淡入
+        decks[current].fadeRate = fadeSeconds > 0.0f ? 1.0f / fadeSeconds : 1.0f;
+        return true;
+    }
+
+    // 选择空闲音轨；两条都在用时，直接停止正在淡出的那条
+    int next = current >= 0 ? 1 - current : (decks[0].active ? 1 : 0);
+    Deck& incoming = decks[next];
+    if (incoming.active) {
+        incoming.stream.stop();
+        incoming.active = false;
+    }
+
+    // open只读取文件头，解码在SFML的音频线程中按块进行
+    if (!incoming.stream.open(filename, bufferMilliseconds, bufferChunks)) {
+        LOG_ERROR(Audio, "Cannot open music track: %s", filename.c_str());
+        return false;
+    }
+
+    // 旧曲目开始淡出
+    if (current >= 0 && decks[current].active) {
+        decks[current].fadeRate = fadeSeconds > 0.0f ? -1.0f / fadeSeconds : -1.0f;
+    }
+
+    incoming.active = true;
+    incoming.volume = fadeSeconds > 0.0f ? 0.0f : 1.0f;
+    incoming.fadeRate = fadeSeconds > 0.0f ? 1.0f / fadeSeconds : 0.0f;
+    applyVolume(incoming);
+    incoming.stream.setLooping(true);
+    incoming.stream.play();
+
+    current = next;
+    return true;
+}
+
+void MusicPlayer::stop(float fadeSeconds) {
+    for (auto& deck : decks) {
+        if (!deck.active) continue;
+
+        if (fadeSeconds > 0.0f) {
+            deck.fadeRate = -1.0f / fadeSeconds;
+        } else {
+            deck.stream.stop();
+            deck.active = false;
+        }
+    }
+    current = -1;
+}
+
+void MusicPlayer::update(float deltaTime) {
+    for (auto& deck : decks) {
+        if (!deck.active || deck.fadeRate == 0.0f) continue;
+
+        deck.volume = std::clamp(deck.volume + deck.fadeRate * deltaTime, 0.0f, 1.0f);
+        applyVolume(deck);
+
+        if (deck.fadeRate > 0.0f && deck.volume >= 1.0f) {
+            deck.fadeRate = 0.0f;
+        } else if (deck.fadeRate < 0.0f && deck.volume <= 0.0f) {
+            deck.stream.stop();
+            deck.active = false;
+            deck.fadeRate = 0.0f;
+        }
+    }
+}
+
+void MusicPlayer::applyVolume(Deck& deck) {
+    deck.stream.setVolume(deck.volume * musicVolume);
+}
+
+void MusicPlayer::setVolume(float volume) {
+    musicVolume = std::clamp(volume, 0.0f, 100.0f);
+    for (auto& deck : decks) {
+        if (deck.active) applyVolume(deck);
+    }
+}
+
+bool MusicPlayer::isPlaying() const {
+    return current >= 0 && decks[current].active;
+}
@@ -0,0 +1,56 @@
+#include "Managers/MusicStream.h"
+#include "Managers/AssetManager.h"
+#include <algorithm>
+
+MusicStream::MusicStream() : chunkSamples(0), chunkCount(0), nextChunk(0) {
+}
+
+bool MusicStream::open(const std::string& path, unsigned int bufferMilliseconds, std::size_t chunks) {
+    stop();
+
+    // 资源包中的曲目直接从映射内存解码，否则从磁盘流式读取
+    AssetBlob blob = AssetManager::getInstance()->findPacked(path);
+    bool opened = blob ? file.openFromMemory(blob.data, blob.size) : file.openFromFile(path);
+    if (!opened) {
+        filename.clear();
+        return false;
+    }
+
+    filename = path;
+
+    const unsigned int channels = file.getChannelCount();
+    const unsigned int sampleRate = file.getSampleRate();
+
+    // 每块至少容纳一帧，块数至少为2（一块播放时解码另一块）
+    chunkSamples = std::max<std::size_t>(static_cast<std::size_t>(sampleRate) * channels * bufferMilliseconds / 1000, channels);
+    chunkCount = std::max<std::size_t>(chunks, 2);
+    nextChunk = 0;
+    ring.assign(chunkSamples * chunkCount, 0);
+    ring.shrink_to_fit();
+
+    initialize(channels, sampleRate, file.getChannelMap());
+    return true;
+}
+
+bool MusicStream::onGetData(Chunk& data) {
+    std::int16_t* samples = ring.data() + nextChunk * chunkSamples;
+    nextChunk = (nextChunk + 1) % chunkCount;
+
+    data.samples = samples;
+    data.sampleCount = static_cast<std::size_t>(file.read(samples, chunkSamples));
+
+    // 读到结尾时返回false，由SoundStream决定是否循环
+    return data.sampleCount == chunkSamples;
+}
+
+void MusicStream::onSeek(sf::Time timeOffset) {
+    file.seek(timeOffset);
+}
+
+const std::string& MusicStream::getFilename() const {
+    return filename;
+}
+
+std::size_t MusicStream::getBufferBytes() const {
+    return ring.capacity() * sizeof(std::int16_t);
+}
@@ -0,0 +1,129 @@
+#include "Managers/SaveJournal.h"
+#include "Utils/MappedFile.h"
+#include "Utils/SaveService.h"
+#include <cstring>
+
+namespace {
+    std::uint32_t checksum(const unsigned char* data, std::size_t size) {
+        std::uint32_t hash = 2166136261u;
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ data[i]) * 16777619u;
+        }
+        return hash;
+    }
+}
+
+SaveJournal::SaveJournal()
+    : interval(0.25f),
+      elapsed(0.0f) {
+}
+
+void SaveJournal::setFile(const std::string& file) {
+    filename = file;
+}
+
+void SaveJournal::setInterval(float seconds) {
+    interval = seconds;
+}
+
+void SaveJournal::record(JournalFormat::RecordType type, std::int32_t value) {
+    if (filename.empty()) {
+        return; // 没有日志文件（无尽模式）
+    }
+    
+    JournalFormat::Record record{};
+    record.type = type;
+    record.value = value;
+    batch.push_back(record);
+}
+
+void SaveJournal::update(float deltaTime) {
+    elapsed += deltaTime;
+    if (elapsed >= interval) {
+        flush();
+    }
+}
+
+void SaveJournal::flush() {
+    elapsed = 0.0f;
+    if (batch.empty() || filename.empty()) {
+        return;
+    }
+
+    // 一批只写一次：8字节批次头 + 每条8字节
+    const std::size_t recordsBytes = batch.size() * sizeof(JournalFormat::Record);
+    bytes.resize(sizeof(JournalFormat::BatchHeader) + recordsBytes);
+    std::memcpy(bytes.data() + sizeof(JournalFormat::BatchHeader), batch.data(), recordsBytes);
+
+    JournalFormat::BatchHeader header{};
+    header.count = static_cast<std::uint32_t>(batch.size());
+    header.checksum = checksum(bytes.data() + sizeof(header), recordsBytes);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+
+    SaveService::getInstance()->append(filename, bytes.data(), bytes.size());
+    batch.clear();
+}
+
+void SaveJournal::reset(std::uint64_t generation) {
+    batch.clear();
+    elapsed = 0.0f;
+    if (filename.empty()) {
+        return;
+    }
+
+    JournalFormat::Header header{};
+    std::memcpy(header.magic, JournalFormat::Magic, sizeof(JournalFormat::Magic));
+    header.version = JournalFormat::Version;
+    header.generation = generation;
+
+    // 替换任务会丢掉排在前面、还没写的追加
+    SaveService::getInstance()->submit(filename, [header](std::vector<unsigned char>& out) {
+        out.resize(sizeof(header));
+        std::memcpy(out.data(), &header, sizeof(header));
+    });
+}
+
+bool SaveJournal::load(const std::string& file, std::uint64_t generation,
+                       std::vector<JournalFormat::Record>& records) {
+    records.clear();
+
+    MappedFile mapped;
+    if (!mapped.open(file)) {
+        return false;
+    }
+
+    const unsigned char* data = mapped.getData();
+    const std::size_t size = mapped.getSize();
+
+    JournalFormat::Header header;
+    if (size < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    // 代数不同说明日志属于更早的存档（整存后还没来得及重写日志）
+    if (std::memcmp(header.magic, JournalFormat::Magic, sizeof(JournalFormat::Magic)) != 0 ||
+        header.version != JournalFormat::Version ||
+        header.generation != generation) {
+        return false;
+    }
+
+    std::size_t offset = sizeof(header);
+    while (size - offset >= sizeof(JournalFormat::BatchHeader)) {
+        JournalFormat::BatchHeader batchHeader;
+        std::memcpy(&batchHeader, data + offset, sizeof(batchHeader));
+        offset += sizeof(batchHeader);
+
+        const std::size_t recordsBytes = static_cast<std::size_t>(batchHeader.count) * sizeof(JournalFormat::Record);
+        if (batchHeader.count == 0 || recordsBytes > size - offset ||
+            checksum(data + offset, recordsBytes) != batchHeader.checksum) {
+            break; // 最后一批没写完整
+        }
+
+        const std::size_t first = records.size();
+        records.resize(first + batchHeader.count);
+        std::memcpy(records.data() + first, data + offset, recordsBytes);
+        offset += recordsBytes;
+    }
+    return true;
+}
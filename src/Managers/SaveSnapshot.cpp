@@ -0,0 +1,131 @@
+#include "Managers/SaveSnapshot.h"
+#include "Utils/MappedFile.h"
+#include "Utils/Logger.h"
+#include <cstring>
+
+namespace {
+    std::uint32_t checksum(const unsigned char* data, std::size_t size) {
+        std::uint32_t hash = 2166136261u;
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ data[i]) * 16777619u;
+        }
+        return hash;
+    }
+
+    std::size_t wordCount(std::uint32_t bricks) {
+        return (static_cast<std::size_t>(bricks) + 63) / 64;
+    }
+}
+
+void SaveSnapshot::setBrickCount(std::uint32_t count) {
+    brickCount = count;
+    brickBits.assign(wordCount(count), 0);
+}
+
+void SaveSnapshot::setBrickActive(std::uint32_t index, bool active) {
+    const std::uint64_t mask = std::uint64_t(1) << (index & 63);
+    if (active) {
+        brickBits[index >> 6] |= mask;
+    } else {
+        brickBits[index >> 6] &= ~mask;
+    }
+}
+
+bool SaveSnapshot::isBrickActive(std::uint32_t index) const {
+    return (brickBits[index >> 6] >> (index & 63)) & 1;
+}
+
+void SaveSnapshot::serialize(std::vector<unsigned char>& out) const {
+    const std::size_t bitsBytes = brickBits.size() * sizeof(std::uint64_t);
+    const std::size_t ballsBytes = balls.size() * sizeof(SaveFormat::BallRecord);
+    const std::size_t payloadSize = sizeof(SaveFormat::Body) + bitsBytes + ballsBytes;
+    out.resize(sizeof(SaveFormat::Header) + payloadSize);
+
+    SaveFormat::Body body{};
+    body.score = score;
+    body.lives = lives;
+    body.level = level;
+    body.flags = ballLaunched ? 1u : 0u;
+    body.paddleX = paddleX;
+    body.paddleY = paddleY;
+    body.rngState = rngState;
+    body.brickCount = brickCount;
+    body.ballCount = static_cast<std::uint32_t>(balls.size());
+    body.generation = generation;
+
+    unsigned char* payload = out.data() + sizeof(SaveFormat::Header);
+    std::memcpy(payload, &body, sizeof(body));
+    if (bitsBytes > 0) {
+        std::memcpy(payload + sizeof(body), brickBits.data(), bitsBytes);
+    }
+    if (ballsBytes > 0) {
+        std::memcpy(payload + sizeof(body) + bitsBytes, balls.data(), ballsBytes);
+    }
+
+    SaveFormat::Header header{};
+    std::memcpy(header.magic, SaveFormat::Magic, sizeof(SaveFormat::Magic));
+    header.version = SaveFormat::Version;
+    header.payloadSize = static_cast<std::uint32_t>(payloadSize);
+    header.checksum = checksum(payload, payloadSize);
+    std::memcpy(out.data(), &header, sizeof(header));
+}
+
+bool SaveSnapshot::deserialize(const unsigned char* data, std::size_t size) {
+    SaveFormat::Header header;
+    if (size < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, SaveFormat::Magic, sizeof(SaveFormat::Magic)) != 0 ||
+        header.version != SaveFormat::Version ||
+        header.payloadSize < sizeof(SaveFormat::Body) ||
+        header.payloadSize > size - sizeof(header)) {
+        return false;
+    }
+
+    const unsigned char* payload = data + sizeof(header);
+    if (checksum(payload, header.payloadSize) != header.checksum) {
+        return false;
+    }
+
+    SaveFormat::Body body;
+    std::memcpy(&body, payload, sizeof(body));
+
+    const std::size_t bitsBytes = wordCount(body.brickCount) * sizeof(std::uint64_t);
+    const std::size_t ballsBytes = static_cast<std::size_t>(body.ballCount) * sizeof(SaveFormat::BallRecord);
+    if (sizeof(body) + bitsBytes + ballsBytes != header.payloadSize) {
+        return false;
+    }
+
+    score = body.score;
+    lives = body.lives;
+    level = body.level;
+    ballLaunched = (body.flags & 1u) != 0;
+    paddleX = body.paddleX;
+    paddleY = body.paddleY;
+    rngState = body.rngState;
+    generation = body.generation;
+
+    setBrickCount(body.brickCount);
+    if (bitsBytes > 0) {
+        std::memcpy(brickBits.data(), payload + sizeof(body), bitsBytes);
+    }
+    balls.resize(body.ballCount);
+    if (ballsBytes > 0) {
+        std::memcpy(balls.data(), payload + sizeof(body) + bitsBytes, ballsBytes);
+    }
+    return true;
+}
+
+bool SaveSnapshot::loadFromFile(const std::string& filename) {
+    MappedFile mapped;
+    if (!mapped.open(filename)) {
+        return false;
+    }
+    if (!deserialize(mapped.getData(), mapped.getSize())) {
+        LOG_WARN(Save, "Save file is corrupted or from another version: %s", filename.c_str());
+        return false;
+    }
+    return true;
+}
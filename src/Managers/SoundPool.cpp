@@ -0,0 +1,137 @@
+#include "Managers/SoundPool.h"
+#include <algorithm>
+
+SoundPool::SoundPool(std::size_t voiceCount) : serial(0), volume(100.0f), enabled(true) {
+    setVoiceCount(voiceCount);
+}
+
+void SoundPool::setVoiceCount(std::size_t voiceCount) {
+    stopAll();
+    voices.clear();
+    voices.resize(std::max<std::size_t>(voiceCount, 1));
+}
+
+std::uint32_t SoundPool::addSound(const sf::SoundBuffer& buffer, int priority, unsigned int maxInstances) {
+    defs.push_back({&buffer, priority, std::max(maxInstances, 1u)});
+    pendingFlags.push_back(0);
+    // 预留空间，保证trigger中的push_back永远不会分配内存
+    pending.reserve(defs.size());
+    return static_cast<std::uint32_t>(defs.size() - 1);
+}
+
+void SoundPool::redefineSound(std::uint32_t index, const sf::SoundBuffer& buffer, int priority, unsigned int maxInstances) {
+    if (index >= defs.size()) {
+        return;
+    }
+
+    // 停止仍在使用旧定义的通道
+    for (auto& voice : voices) {
+        if (voice.sound && voice.def == index) {
+            voice.sound->stop();
+        }
+    }
+    defs[index] = {&buffer, priority, std::max(maxInstances, 1u)};
+}
+
+bool SoundPool::isBusy(const Voice& voice) {
+    return voice.sound && voice.sound->getStatus() != sf::SoundSource::Status::Stopped;
+}
+
+SoundPool::Voice* SoundPool::acquireVoice(std::uint32_t def) {
+    const SoundDef& sound = defs[def];
+
+    Voice* freeVoice = nullptr;
+    Voice* oldestSame = nullptr;
+    Voice* victim = nullptr;
+    unsigned int instances = 0;
+
+    for (auto& voice : voices) {
+        if (!isBusy(voice)) {
+            if (!freeVoice) freeVoice = &voice;
+            continue;
+        }
+
+        if (voice.def == def) {
+            ++instances;
+            if (!oldestSame || voice.startSerial < oldestSame->startSerial) {
+                oldestSame = &voice;
+            }
+        }
+
+        // 抢占候选：优先级最低，其次最早开始播放
+        if (!victim || voice.priority < victim->priority ||
+            (voice.priority == victim->priority && voice.startSerial < victim->startSerial)) {
+            victim = &voice;
+        }
+    }
+
+    // 达到同时发声上限时，复用该音效最早的实例
+    if (instances >= sound.maxInstances) {
+        return oldestSame;
+    }
+
+    if (freeVoice) {
+        return freeVoice;
+    }
+
+    // 池已满：只抢占优先级不高于自身的通道
+    if (victim && victim->priority <= sound.priority) {
+        return victim;
+    }
+    return nullptr;
+}
+
+void SoundPool::flush() {
+    if (pending.empty()) {
+        return;
+    }
+
+    for (std::uint32_t def : pending) {
+        pendingFlags[def] = 0;
+        if (!enabled) {
+            continue;
+        }
+
+        Voice* voice = acquireVoice(def);
+        if (!voice) {
+            continue;
+        }
+
+        const SoundDef& sound = defs[def];
+        if (!voice->sound) {
+            voice->sound.emplace(*sound.buffer);
+        } else {
+            voice->sound->stop();
+            if (&voice->sound->getBuffer() != sound.buffer) {
+                voice->sound->setBuffer(*sound.buffer);
+            }
+        }
+
+        voice->def = def;
+        voice->priority = sound.priority;
+        voice->startSerial = ++serial;
+        voice->sound->setVolume(volume);
+        voice->sound->play();
+    }
+
+    pending.clear();
+}
+
+void SoundPool::stopAll() {
+    for (auto& voice : voices) {
+        if (voice.sound) {
+            voice.sound->stop();
+        }
+    }
+}
+
+void SoundPool::setVolume(float newVolume) {
+    volume = std::clamp(newVolume, 0.0f, 100.0f);
+}
+
+void SoundPool::setEnabled(bool isEnabled) {
+    enabled = isEnabled;
+    if (!enabled) {
+        stopAll();
+    }
+}
@@ -3,7 +3,7 @@
 #include "States/MenuState.h"
 #include "States/PlayState.h"
 #include "Managers/AssetManager.h"
-#include <iostream>
+#include "Utils/Logger.h"
 
 GameOverState::GameOverState(Game* game, int score)
     : GameState(game),
@@ -18,7 +18,7 @@ GameOverState::GameOverState(Game* game, int score)
 
 void GameOverState::init() { //设置背景、字体、菜单项
     // 获取窗口大小
-    sf::Vector2u windowSize = game->getWindow().getSize();
+    sf::Vector2u windowSize = game->getSize();
     
     // 初始化背景
     background.setSize(sf::Vector2f(windowSize));
@@ -52,10 +52,10 @@ void GameOverState::init() { //设置背景、字体、菜单项
                 windowSize.y * 0.3f
             ));
         } else {
-            std::cerr << "Warning: Could not load font, using default font" << std::endl;
+            LOG_WARN(Assets, "Could not load font, using default font");
         }
     } catch (const std::exception& e) {
-        std::cerr << "Error loading font: " << e.what() << std::endl;
+        LOG_ERROR(Assets, "Error loading font: %s", e.what());
     }
     
     // 设置菜单位置
@@ -83,7 +83,7 @@ void GameOverState::init() { //设置背景、字体、菜单项
 float scale = 0.0f;
 void GameOverState::initEndGameScreen() {
     // 获取窗口大小
-    sf::Vector2u windowSize = game->getWindow().getSize();
+    sf::Vector2u windowSize = game->getSize();
     
     // 初始化背景
     if (AssetManager::getInstance()->hasTexture("endGame_back")) {
@@ -366,7 +366,7 @@ void GameOverState::setFinalScore(int score) {
         
         // 重新居中分数文本
         sf::FloatRect scoreBounds = scoreText->getLocalBounds();
-        sf::Vector2u windowSize = game->getWindow().getSize();
+        sf::Vector2u windowSize = game->getSize();
         scoreText->setPosition(sf::Vector2f(
             (windowSize.x - scoreBounds.size.x) / 2.0f,
             windowSize.y * 0.3f
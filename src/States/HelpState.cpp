@@ -14,7 +14,7 @@ HelpState::HelpState(Game* game)
 
 void HelpState::init() { //设置背景、字体、菜单项
     // 获取窗口大小
-    sf::Vector2u windowSize = game->getWindow().getSize();
+    sf::Vector2u windowSize = game->getSize();
     
     // 初始化背景
     background.setSize(sf::Vector2f(windowSize));
@@ -101,7 +101,7 @@ void HelpState::initMenuItems() { //设置菜单项
         Config::getInstance().setValue("game.paddle_speed", 200.0f);
         Config::getInstance().setValue("reward.max_balls", 10);
         Config::getInstance().setValue("reward.ball_spawn_chance", 50);
-        Config::getInstance().save();
+        Config::getInstance().saveAsync();
     });
     
     // 添加困难模式选项
@@ -111,7 +111,7 @@ void HelpState::initMenuItems() { //设置菜单项
         Config::getInstance().setValue("game.paddle_speed", 400.0f);
         Config::getInstance().setValue("reward.max_balls", 5);
         Config::getInstance().setValue("reward.ball_spawn_chance", 30);
-        Config::getInstance().save();
+        Config::getInstance().saveAsync();
     });
     
     // 添加返回菜单选项
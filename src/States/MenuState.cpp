@@ -3,7 +3,7 @@
 #include "States/PlayState.h"
 #include "States/HelpState.h"
 #include "Managers/AssetManager.h"
-#include <iostream>
+#include "Utils/Logger.h"
 
 MenuState::MenuState(Game* game)
     : GameState(game),
@@ -14,7 +14,7 @@ MenuState::MenuState(Game* game)
 
 void MenuState::init() { //设置背景、字体、菜单项
     // 获取窗口大小
-    sf::Vector2u windowSize = game->getWindow().getSize();
+    sf::Vector2u windowSize = game->getSize();
     
     // 初始化背景
     background.setSize(sf::Vector2f(windowSize));
@@ -39,10 +39,10 @@ void MenuState::init() { //设置背景、字体、菜单项
                 windowSize.y * 0.15f
             ));
         } else {
-            std::cerr << "Warning: Could not load font, using default font" << std::endl;
+            LOG_WARN(Assets, "Could not load font, using default font");
         }
     } catch (const std::exception& e) {
-        std::cerr << "Error loading font: " << e.what() << std::endl;
+        LOG_ERROR(Assets, "Error loading font: %s", e.what());
     }
     
     // 设置菜单位置
@@ -74,6 +74,10 @@ void MenuState::initMenuItems() { //设置菜单项
         game->changeState(std::move(playState));
     });
     
+    addMenuItem("Endless Mode", [this]() {
+        game->changeState(std::make_unique<PlayState>(game, true));
+    });
+    
     addMenuItem("Help", [this]() {
         game->changeState(std::make_unique<HelpState>(game));
     });
@@ -216,7 +220,7 @@ void MenuState::setTitle(const std::string& title) {
     
         // 重新居中标题 - SFML 3.0.0中FloatRect使用size
         sf::FloatRect titleBounds = titleText->getLocalBounds();
-    sf::Vector2u windowSize = game->getWindow().getSize();
+    sf::Vector2u windowSize = game->getSize();
         titleText->setPosition(sf::Vector2f(
             (windowSize.x - titleBounds.size.x) / 2.0f,
         windowSize.y * 0.15f
@@ -3,7 +3,7 @@
 #include "States/PlayState.h"
 #include "States/MenuState.h"
 #include "Managers/AssetManager.h"
-#include <iostream>
+#include "Utils/Logger.h"
 
 PauseState::PauseState(Game* game)
     : GameState(game),
@@ -14,7 +14,7 @@ PauseState::PauseState(Game* game)
 
 void PauseState::init() { //设置背景、字体、菜单项
     // 获取窗口大小
-    sf::Vector2u windowSize = game->getWindow().getSize();
+    sf::Vector2u windowSize = game->getSize();
     
     // 初始化半透明背景
     background.setSize(sf::Vector2f(windowSize));
@@ -37,10 +37,10 @@ void PauseState::init() { //设置背景、字体、菜单项
                 windowSize.y * 0.25f
             ));
         } else {
-            std::cerr << "Warning: Could not load font, using default font" << std::endl;
+            LOG_WARN(Assets, "Could not load font, using default font");
         }
     } catch (const std::exception& e) {
-        std::cerr << "Error loading font: " << e.what() << std::endl;
+        LOG_ERROR(Assets, "Error loading font: %s", e.what());
     }
     
     // 设置菜单位置
@@ -3,45 +3,83 @@
 #include "States/PauseState.h"
 #include "States/GameOverState.h"
 #include "Managers/AssetManager.h"
+#include "Managers/MusicPlayer.h"
+#include "Managers/SaveSnapshot.h"
+#include "Utils/Utils.h"
 #include "Utils/Config.h"
-#include <iostream>
-#include <fstream>
+#include "Utils/SaveService.h"
+#include "Utils/FrameProfiler.h"
+#include "Utils/Tracer.h"
+#include "Utils/FlightRecorder.h"
+#include "Utils/AllocTracker.h"
+#include "Utils/Logger.h"
+#include <algorithm>
 #include <cmath>
-#include <filesystem>
+#include <chrono>
+#include <optional>
+#include <random>
 
-PlayState::PlayState(Game* game) 
+namespace {
+    // 代数起点每局随机选取：新的一局第一次整存的代数不会和以前留下的日志相同
+    // （不用 Utils::Random，它的状态属于游戏本身，会写进存档）
+    std::uint64_t makeSaveGeneration() {
+        std::random_device device;
+        std::uint64_t seed = (static_cast<std::uint64_t>(device()) << 32) ^ device();
+        seed ^= static_cast<std::uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+        return LevelGenerator::mix(seed);
+    }
+}
+
+PlayState::PlayState(Game* game, bool endless) 
     : GameState(game),
+      endlessMode(endless),
       score(0),
-      lives(Config::getInstance().getValue("game.initial_lives", 3)),
+      lives(Config::getInstance().getSettings().initialLives),
       ballLaunched(false),
       gameOver(false),
       levelCompleted(false),
       justGameOver(false),
+      saveGeneration(makeSaveGeneration()),
       paddleMovingLeft(false),
-      paddleMovingRight(false) {
+      paddleMovingRight(false),
+      shownScore(-1),
+      shownLives(-1) {
     // 加载奖励机制设置
     loadRewardSettings();
 }
 
+PlayState::~PlayState() {
+    for (int id : settingSubscriptions) {
+        Config::getInstance().unsubscribe(id);
+    }
+}
+
 void PlayState::init() { //设置碰撞管理、关卡管理和初始化游戏
     // Get window size
-    sf::Vector2u windowSize = game->getWindow().getSize();
+    sf::Vector2u windowSize = game->getSize();
+    
+    // 解析资源句柄
+    AssetManager* assets = AssetManager::getInstance();
+    ballTexture = assets->findTexture("ball"_asset);
+    paddleTexture = assets->findTexture("paddle"_asset);
+    backgroundTexture = assets->findTexture("background"_asset);
+    breakSound = assets->findSound("break"_asset);
+    hitSound = assets->findSound("hit"_asset);
+    
+    // 球的纹理解析后再预先创建备用的球
+    reserveBalls();
     
     // Set collision manager
     collisionManager.setWindowSize(windowSize);
     
     // Set collision callbacks
-    collisionManager.setOnBrickHitCallback([this](Brick* brick) {
-        if (brick) {
-            this->addScore(brick->getScore());
-            AssetManager::getInstance()->playSound("break");
-        }
-    });
-    
     collisionManager.setOnBallPaddleCollisionCallback([this]() {
-        AssetManager::getInstance()->playSound("hit");
+        AssetManager::getInstance()->playSound(hitSound);
     });
     
+    // 配置热重载时更新正在进行的这一局
+    subscribeSettings();
+    
     // Initialize level manager
     std::vector<std::string> levelFiles = {
         "resources/levels/level1.txt",
@@ -85,7 +123,7 @@ void PlayState::init() { //设置碰撞管理、关卡管理和初始化游戏
                 windowSize.x / 2.0f,
                 windowSize.y * 0.7f
             ));
-
+            
             messageText2 = std::make_unique<sf::Text>(font, "", 30);
             messageText2->setFillColor(sf::Color::Yellow);
             messageText2->setStyle(sf::Text::Bold);
@@ -99,25 +137,36 @@ void PlayState::init() { //设置碰撞管理、关卡管理和初始化游戏
             ));
             
         } else {
-            std::cerr << "Warning: Could not load font, using default font" << std::endl;
+            LOG_WARN(Assets, "Could not load font, using default font");
         }
     } catch (const std::exception& e) {
-                    std::cerr << "Error loading font: " << e.what() << std::endl;
+        LOG_ERROR(Assets, "Error loading font: %s", e.what());
+    }
+    
+    // 无尽模式每次都是新的一局；自动挡板（挂机测试）也总是新开一局，不读写玩家的存档和日志
+    if (endlessMode || autopilot) {
+        initGame();
+        return;
     }
     
+    // 自动存档日志
+    const GameSettings& settings = Config::getInstance().getSettings();
+    journal.setFile(settings.saveJournalFile);
+    journal.setInterval(settings.autosaveIntervalMs / 1000.0f);
+    
     // 尝试加载存档，如果失败则初始化新游戏
-    std::cout << "Attempting to load game state..." << std::endl;
+    LOG_DEBUG(Save, "Attempting to load game state...");
     if (!loadGameState()) {
-        std::cout << "Failed to load game state, initializing new game" << std::endl;
+        LOG_INFO(Save, "Failed to load game state, initializing new game");
         initGame();
     } else {
-        std::cout << "Game state loaded successfully" << std::endl;
+        LOG_INFO(Save, "Game state loaded successfully");
     }
 }
 
 void PlayState::initGame() { //创建实体和更新ui
     // Get window size
-    sf::Vector2u windowSize = game->getWindow().getSize();
+    sf::Vector2u windowSize = game->getSize();
     
     // Create paddle
     paddle = std::make_unique<Paddle>(
@@ -129,15 +178,15 @@ void PlayState::initGame() { //创建实体和更新ui
     paddle->setWindowWidth(static_cast<float>(windowSize.x));
     
     // Set paddle speed from config
-    paddle->setMaxSpeed(Config::getInstance().getValue("game.paddle_speed", 500.0f));
+    paddle->setMaxSpeed(Config::getInstance().getSettings().paddleSpeed);
     
     // Set paddle texture
-    if (AssetManager::getInstance()->hasTexture("paddle")) {
-        paddle->setTexture(AssetManager::getInstance()->getTexture("paddle"));
+    if (paddleTexture.isValid()) {
+        paddle->setTexture(AssetManager::getInstance()->getTexture(paddleTexture));
     }
     
     // 清空现有的球
-    balls.clear();
+    releaseAllBalls();
     
     // 创建初始球
     auto initialBall = createNewBall(
@@ -146,19 +195,26 @@ void PlayState::initGame() { //创建实体和更新ui
     );
     
     // Load first level
-    GameState::currentLevel = 0;
-    loadLevel(GameState::currentLevel);
+    if (endlessMode) {
+        startEndless();
+    } else {
+        GameState::currentLevel = 0;
+        loadLevel(GameState::currentLevel);
+    }
     
     // Reset state
     ballLaunched = false;
     gameOver = false;
     levelCompleted = false;
     score = 0;
-    lives = Config::getInstance().getValue("game.initial_lives", 3);
+    lives = Config::getInstance().getSettings().initialLives;
     justGameOver = false;
     
     // Update UI
     updateUI();
+    
+    // 新的一局从一次整存开始，之后只写增量
+    saveGameState();
 }
 
 void PlayState::handleInput(const sf::Event& event) { //输入事件
@@ -189,7 +245,7 @@ void PlayState::handleInput(const sf::Event& event) { //输入事件
     // 处理键盘按下事件
     if (event.is<sf::Event::KeyPressed>()) {
         const auto* keyEvent = event.getIf<sf::Event::KeyPressed>();
-        if (keyEvent && !gameOver && !levelCompleted) {
+        if (keyEvent && !gameOver && !levelCompleted && !autopilot) {
             // 设置挡板移动标志
             if (keyEvent->code == sf::Keyboard::Key::Left || keyEvent->code == sf::Keyboard::Key::A) {
                 paddleMovingLeft = true;
@@ -216,6 +272,29 @@ void PlayState::handleInput(const sf::Event& event) { //输入事件
 }
 
 void PlayState::update(float deltaTime) { //更新实体和ui
+    // 定时把攒下的增量写入日志
+    {
+        AllocTracker::TagScope tag(AllocTracker::Save);
+        journal.update(deltaTime);
+    }
+    
+    // 自动挡板不进入结束画面，直接重开一局；过关后自动进入下一关
+    if (autopilot && gameOver) {
+        LOG_INFO(Core, "Autopilot: game over on level %d with score %d, restarting",
+                 levelManager.getCurrentLevel() + 1, score);
+        restartGame();
+        return;
+    }
+    if (autopilot && levelCompleted) {
+        if (levelManager.hasNextLevel()) {
+            loadNextLevel();
+        } else {
+            // 打完最后一关从头再来
+            restartGame();
+        }
+        return;
+    }
+    
     // 如果游戏刚结束，切换到GameOverState
     if (gameOver && !justGameOver) {
         justGameOver = true;
@@ -227,6 +306,19 @@ void PlayState::update(float deltaTime) { //更新实体和ui
         return;
     }
     
+    AllocTracker::TagScope tag(AllocTracker::Play);
+    FrameProfiler* profiler = FrameProfiler::getInstance();
+    std::optional<FrameProfiler::Scope> phase;
+    phase.emplace(FrameProfiler::Entities);
+    
+    // 自动挡板代替键盘：自动发球，挡板移向预测的落点
+    if (autopilot && paddle) {
+        if (!ballLaunched) {
+            launchBall();
+        }
+        movePaddle(autopilot->update(balls, *paddle, deltaTime));
+    }
+    
     // 如果没有球被发射，让第一个球跟随挡板
     if (!ballLaunched && !balls.empty()) {
         balls[0]->setPosition(sf::Vector2f(
@@ -249,6 +341,13 @@ void PlayState::update(float deltaTime) { //更新实体和ui
         }
     }
     
+    // Update bricks
+    for (auto& brick : bricks) {
+        if (brick->isActive()) {
+            brick->update(deltaTime);
+        }
+    }
+    
     if (ballLaunched) {
         // 更新所有球
         for (auto it = balls.begin(); it != balls.end();) {
@@ -257,37 +356,55 @@ void PlayState::update(float deltaTime) { //更新实体和ui
         ball->update(deltaTime);
                 // 检查球是否掉落
         if (collisionManager.isBallLost(ball.get())) {
-                    // 移除掉落的球
+                    // 移除掉落的球（放回备用列表）
+                    ++stats.ballsLost;
+                    spareBalls.push_back(std::move(*it));
                     it = balls.erase(it);
+                    FlightRecorder::getInstance()->record(FlightRecorder::BallLost, static_cast<int>(balls.size()));
                     continue;
                 }
                 ++it;
             } else {
+                spareBalls.push_back(std::move(*it));
                 it = balls.erase(it);
             }
         }
         
         // 检查碰撞
-        collisionManager.update(balls, paddle.get(), bricks);
+        phase.emplace(FrameProfiler::Collision);
+        if (endlessMode) {
+            collisionManager.update(balls, paddle.get(), endlessField);
+        } else {
+            collisionManager.update(balls, paddle.get(), bricks);
+        }
+        profiler->addPairTests(collisionManager.getPairTests());
+        TRACE_COUNTER("pair_tests", collisionManager.getPairTests());
+        
+        phase.emplace(FrameProfiler::Status);
+        
+        // 碰撞检测遍历完球之后再处理击碎的砖块（可能会加球）
+        for (Brick* brick : collisionManager.getDestroyedBricks()) {
+            onBrickDestroyed(brick);
+        }
+        
+        if (endlessMode) {
+            // 砖块场下移，有砖块的行越过失守线就扣一条命
+            int breached = endlessField.update(deltaTime);
+            if (breached > 0) {
+                lives = std::max(0, lives - breached);
+                if (lives <= 0) {
+                    showGameOver();
+                }
+                updateUI();
+            }
+        }
         
         // 检查是否所有球都消失了
-        if (balls.empty()) {
+        if (balls.empty() && !gameOver) {
             lives--;
+            journal.record(JournalFormat::LifeLost, lives);
             if (lives <= 0) {
-                gameOver = true;
-                if (messageText1) {
-                    messageText1->setString("Game Over! Press ESC for Menu");
-                    // 重新计算并设置原点以居中
-                    sf::FloatRect messageBounds = messageText1->getLocalBounds();
-                    messageText1->setOrigin({messageBounds.size.x / 2.0f, messageBounds.size.y / 2.0f});
-                    
-                    // 获取窗口大小并设置位置
-                    sf::Vector2u windowSize = game->getWindow().getSize();
-                    messageText1->setPosition(sf::Vector2f(
-                        windowSize.x / 2.0f,
-                        windowSize.y * 0.7f
-                    ));
-                }
+                showGameOver();
             } else {
                 resetBallAndPaddle();
             }
@@ -295,21 +412,27 @@ void PlayState::update(float deltaTime) { //更新实体和ui
         }
     }
     
-    // Update bricks
-    for (auto& brick : bricks) {
-        if (brick->isActive()) {
-            brick->update(deltaTime);
-        }
+    phase.emplace(FrameProfiler::Status);
+    if (profiler->isEnabled()) {
+        int activeBricks = endlessMode ? endlessField.getBrickCount()
+                                       : static_cast<int>(std::count_if(bricks.begin(), bricks.end(),
+                                             [](const Brick* brick) { return brick->isActive(); }));
+        profiler->setEntityCounts(static_cast<std::uint32_t>(balls.size()), static_cast<std::uint32_t>(activeBricks));
     }
     
     // Check if all bricks are destroyed
     checkGameStatus();
+    
+    // 正常游戏中的帧：分配守卫检查这些帧
+    if (ballLaunched && !gameOver && !levelCompleted) {
+        AllocTracker::markSteadyFrame();
+    }
 }
 
 void PlayState::render(sf::RenderWindow& window) { //渲染实体和ui
     // 绘制背景图片
-    if (AssetManager::getInstance()->hasTexture("background")) {
-        sf::Sprite backgroundSprite(AssetManager::getInstance()->getTexture("background"));
+    if (backgroundTexture.isValid()) {
+        sf::Sprite backgroundSprite(AssetManager::getInstance()->getTexture(backgroundTexture));
         
         // 调整背景图片大小以适应窗口
         sf::Vector2u windowSize = window.getSize();
@@ -320,10 +443,10 @@ void PlayState::render(sf::RenderWindow& window) { //渲染实体和ui
         backgroundSprite.setScale({scaleX, scaleY});
         
         window.draw(backgroundSprite);
+        FrameProfiler::getInstance()->countDrawCall();
     } else {
         // 如果没有背景图片，使用配置中的颜色
-        sf::Color bgColor = Config::getInstance().getValue("colors.background", sf::Color(20, 20, 50));
-        window.clear(bgColor);
+        window.clear(Config::getInstance().getSettings().backgroundColor);
     }
     
     // Draw entities
@@ -342,11 +465,20 @@ void PlayState::render(sf::RenderWindow& window) { //渲染实体和ui
         }
     }
     
+    if (endlessMode) {
+        endlessField.render(window);
+    }
+    
     // Draw UI
     if (scoreText) window.draw(*scoreText);
     if (livesText) window.draw(*livesText);
     if (messageText1) window.draw(*messageText1);
     if (messageText2) window.draw(*messageText2);
+    
+    FrameProfiler* profiler = FrameProfiler::getInstance();
+    for (const auto* text : {scoreText.get(), livesText.get(), messageText1.get(), messageText2.get()}) {
+        if (text) profiler->countDrawCall();
+    }
 }
 
 void PlayState::launchBall() {
@@ -354,7 +486,7 @@ void PlayState::launchBall() {
         ballLaunched = true;
         
         // Get ball speed from config
-        float ballSpeed = Config::getInstance().getValue("game.ball_speed", 300.0f);
+        float ballSpeed = Config::getInstance().getSettings().ballSpeed;
         
         // Calculate initial velocity components
         float vx = ballSpeed * 0.5f; // Horizontal component (adjust as needed)
@@ -376,10 +508,10 @@ void PlayState::resetBallAndPaddle() {
     if (!paddle) return;
     
     // 清空所有球
-    balls.clear();
+    releaseAllBalls();
     
     // 创建新的初始球
-    sf::Vector2u windowSize = game->getWindow().getSize();
+    sf::Vector2u windowSize = game->getSize();
     createNewBall(
         sf::Vector2f(windowSize.x / 2.0f - 10.0f, windowSize.y - 80.0f),
         sf::Vector2f(0, 0)
@@ -413,6 +545,11 @@ void PlayState::resetBallAndPaddle() {
 }
 
 void PlayState::checkGameStatus() {
+    // 无尽模式没有过关
+    if (endlessMode) {
+        return;
+    }
+    
     // Check if all bricks are destroyed
     bool allBricksDestroyed = true;
     for (const auto& brick : bricks) {
@@ -424,6 +561,12 @@ void PlayState::checkGameStatus() {
     
     if (allBricksDestroyed) {
         levelCompleted = true;
+        ++stats.levelsCleared;
+        if (autopilot) {
+            LOG_INFO(Core, "Autopilot: level %d cleared in %.1f s (score %d, lives %d)",
+                     levelManager.getCurrentLevel() + 1, autopilot->getLevelTime(), score, lives);
+        }
+        
         if (levelManager.hasNextLevel()) {
             // 更新消息文本
             if (messageText1) {
@@ -440,26 +583,139 @@ void PlayState::checkGameStatus() {
                 messageText2->setOrigin({messageBounds.size.x / 2.0f, messageBounds.size.y / 2.0f});
                 
                 // 获取窗口大小并设置位置
-                sf::Vector2u windowSize = game->getWindow().getSize();
+                sf::Vector2u windowSize = game->getSize();
                 messageText2->setPosition(sf::Vector2f(
                     windowSize.x / 2.0f,
                     windowSize.y * 0.75f  // 稍微低于messageText1
                 ));
             }
-        } else {
+        } else if (!autopilot) {
             game->pushState(std::make_unique<GameOverState>(game, score));
         }
     }
 }
 
+void PlayState::startEndless() {
+    bricks.clear();
+    
+    // 种子为0时每局随机，否则固定（用于复现）
+    int seed = Config::getInstance().getSettings().endlessSeed;
+    if (seed == 0) {
+        seed = Utils::Random::getInt(1, 0x7FFFFFFF);
+    }
+    
+    // 砖块行碰到挡板所在高度即失守
+    levelManager.initEndless(endlessField, static_cast<std::uint64_t>(seed), paddle->getPosition().y);
+}
+
+void PlayState::showGameOver() {
+    gameOver = true;
+    if (messageText1) {
+        messageText1->setString("Game Over! Press ESC for Menu");
+        // 重新计算并设置原点以居中
+        sf::FloatRect messageBounds = messageText1->getLocalBounds();
+        messageText1->setOrigin({messageBounds.size.x / 2.0f, messageBounds.size.y / 2.0f});
+        
+        // 获取窗口大小并设置位置
+        sf::Vector2u windowSize = game->getSize();
+        messageText1->setPosition(sf::Vector2f(
+            windowSize.x / 2.0f,
+            windowSize.y * 0.7f
+        ));
+    }
+}
+
+bool PlayState::startLevel(int levelNumber) {
+    if (endlessMode || levelNumber < 0 || levelNumber >= levelManager.getTotalLevels()) {
+        return false;
+    }
+    GameState::currentLevel = levelNumber;
+    loadLevel(levelNumber);
+    return enterLevel();
+}
+
+bool PlayState::startGeneratedLevel(const LevelGenerator::Params& params) {
+    if (endlessMode) {
+        return false;
+    }
+    bricks = levelManager.generateLevel(params);
+    return enterLevel();
+}
+
+bool PlayState::enterLevel() {
+    levelCompleted = false;
+    gameOver = false;
+    justGameOver = false;
+    resetBallAndPaddle();
+    if (autopilot) {
+        autopilot->reset();
+    }
+    
+    saveGameState();
+    updateUI();
+    return !bricks.empty();
+}
+
+void PlayState::addBall() {
+    if (!paddle) {
+        return;
+    }
+    
+    const float radius = 10.0f;
+    const float speed = Config::getInstance().getSettings().ballSpeed;
+    const float angle = Utils::Random::getFloat(-60.0f, 60.0f) * 3.14159f / 180.0f;
+    createNewBall(sf::Vector2f(paddle->getPosition().x + paddle->getSize().x / 2.0f - radius,
+                               paddle->getPosition().y - radius * 2.0f - 1.0f),
+                  sf::Vector2f(std::sin(angle) * speed, -std::cos(angle) * speed));
+}
+
 void PlayState::loadLevel(int levelNumber) {
     bricks = levelManager.loadLevel(levelNumber);
+    playLevelMusic(levelNumber);
+}
+
+void PlayState::playLevelMusic(int levelNumber) {
+    // 每关的曲目可在配置中用 file.music_levelN 指定，缺省为 resources/music/levelN.ogg
+    std::string levelName = std::to_string(levelNumber + 1);
+    std::string track = Config::getInstance().getValue("file.music_level" + levelName,
+                                                       "resources/music/level" + levelName + ".ogg");
+    if (AssetManager::getInstance()->findPacked(track) || Utils::File::exists(track)) {
+        MusicPlayer::getInstance()->play(track, Config::getInstance().getSettings().musicFade);
+    }
+}
+
+void PlayState::onExit() {
+    journal.flush();
+    MusicPlayer::getInstance()->stop(Config::getInstance().getSettings().musicFade);
 }
 
 void PlayState::startNewGame() {
     initGame();
 }
 
+void PlayState::setAutoPlay(bool enabled) {
+    const GameSettings& settings = Config::getInstance().getSettings();
+    if (!enabled) {
+        const bool wasEnabled = autopilot.has_value();
+        autopilot = std::nullopt;
+        if (wasEnabled && !endlessMode) {
+            // 交还给玩家：重新打开日志，从当前局面整存一次
+            journal.setFile(settings.saveJournalFile);
+            saveGameState();
+        }
+        return;
+    }
+    
+    // 自动挡板的局面不写进存档和日志（日志文件为空时不记录）
+    journal.setFile("");
+    autopilot.emplace(static_cast<float>(game->getSize().x),
+                      settings.autopilotSkill, settings.autopilotReaction);
+    
+    // 之前按住的方向键不再起作用
+    paddleMovingLeft = false;
+    paddleMovingRight = false;
+}
+
 int PlayState::getScore() const {
     return score;
 }
@@ -476,8 +732,17 @@ bool PlayState::isLevelCompleted() const {
     return levelCompleted;
 }
 
+std::size_t PlayState::getBallCount() const {
+    return balls.size();
+}
+
+const PlayState::Stats& PlayState::getStats() const {
+    return stats;
+}
+
 void PlayState::addScore(int points) {
     score += points;
+    journal.record(JournalFormat::ScoreDelta, points);
     updateUI();
     
     // 尝试触发奖励机制
@@ -487,27 +752,55 @@ void PlayState::addScore(int points) {
     }
 }
 
+void PlayState::onBrickDestroyed(Brick* brick) {
+    ++stats.bricksDestroyed;
+    addScore(brick->getScore());
+    AssetManager::getInstance()->playSound(breakSound);
+    
+    // 下标在创建砖块时记下，不用在列表里查找
+    if (brick->getIndex() >= 0) {
+        journal.record(JournalFormat::BrickDestroyed, brick->getIndex());
+    }
+}
+
 void PlayState::updateUI() {
-    if (scoreText) scoreText->setString("Score: " + std::to_string(score));
-    if (livesText) livesText->setString("Lives: " + std::to_string(lives));
+    AllocTracker::TagScope tag(AllocTracker::UI);
+    
+    // 数值没变时不重建文字；变化时格式化到已有的字符串里，不产生临时字符串
+    if (scoreText && score != shownScore) {
+        shownScore = score;
+        Utils::String::formatTo(scoreString, "Score: %d", score);
+        scoreText->setString(scoreString);
+    }
+    if (livesText && lives != shownLives) {
+        shownLives = lives;
+        Utils::String::formatTo(livesString, "Lives: %d", lives);
+        livesText->setString(livesString);
+    }
 }
 
 void PlayState::loadNextLevel() {
     // Load the next level
     GameState::currentLevel = levelManager.getCurrentLevel();
     bricks = levelManager.loadLevel(GameState::currentLevel + 1);
+    playLevelMusic(levelManager.getCurrentLevel());
     
     // Reset game state for new level
     levelCompleted = false;
     ballLaunched = false;
     
     // Maintain the current score but reset lives to initial value
-    lives = Config::getInstance().getValue("game.initial_lives", 3);
+    lives = Config::getInstance().getSettings().initialLives;
     
     // Reset ball and paddle positions
     resetBallAndPaddle();
+    if (autopilot) {
+        autopilot->reset();
+    }
     
-    // 保存游戏状态，以便在关卡切换后仍能恢复
+    // 关卡切换时整存一次，日志从新关卡重新开始
+    journal.record(JournalFormat::LevelChange, levelManager.getCurrentLevel());
+    journal.flush();
     saveGameState();
     
     // Update message and UI
@@ -518,7 +811,7 @@ void PlayState::loadNextLevel() {
         messageText1->setOrigin({messageBounds.size.x / 2.0f, messageBounds.size.y / 2.0f});
         
         // 获取窗口大小并设置位置
-        sf::Vector2u windowSize = game->getWindow().getSize();
+        sf::Vector2u windowSize = game->getSize();
         messageText1->setPosition(sf::Vector2f(
             windowSize.x / 2.0f,
             windowSize.y * 0.7f
@@ -538,7 +831,7 @@ void PlayState::restartGame() {
     score = 0;
     
     // Reset lives to initial value from config
-    lives = Config::getInstance().getValue("game.initial_lives", 3);
+    lives = Config::getInstance().getSettings().initialLives;
     
     // Reset game state
     gameOver = false;
@@ -547,21 +840,31 @@ void PlayState::restartGame() {
     justGameOver = false;
     
     // Load first level
-    GameState::currentLevel = 0;
-    loadLevel(GameState::currentLevel);
+    if (endlessMode) {
+        startEndless();
+    } else {
+        GameState::currentLevel = 0;
+        loadLevel(GameState::currentLevel);
+    }
     
     // Reset ball and paddle positions
     resetBallAndPaddle();
+    if (autopilot) {
+        autopilot->reset();
+    }
     
     // Update UI
     updateUI();
     
+    // 重新开始也是一个整存点
+    saveGameState();
+    
     // Update message
     if (messageText1) {
         messageText1->setString("Press Space to Launch Ball");
         
         // Reset message position (in case it was moved for congratulations message)
-        sf::Vector2u windowSize = game->getWindow().getSize();
+        sf::Vector2u windowSize = game->getSize();
         sf::FloatRect messageBounds = messageText1->getLocalBounds();
         messageText1->setOrigin({messageBounds.size.x / 2.0f, messageBounds.size.y / 2.0f});
         messageText1->setPosition(sf::Vector2f(
@@ -573,24 +876,85 @@ void PlayState::restartGame() {
 
 void PlayState::loadRewardSettings() {
     // 从配置中加载奖励机制设置
-    Config& config = Config::getInstance();
+    const GameSettings& settings = Config::getInstance().getSettings();
     
     // 多球功能始终启用
     multiballEnabled = true;
-    maxBalls = config.getValue("reward.max_balls", 3);
-    ballSpawnChance = config.getValue("reward.ball_spawn_chance", 30);
+    maxBalls = settings.maxBalls;
+    ballSpawnChance = settings.ballSpawnChance;
+}
+
+void PlayState::reserveBalls() {
+    // 预先创建到最大球数，游戏中生成新球只从备用列表里取
+    const std::size_t target = static_cast<std::size_t>(std::max(maxBalls, 1));
+    balls.reserve(target);
+    spareBalls.reserve(target);
+    while (balls.size() + spareBalls.size() < target) {
+        auto ball = std::make_unique<Ball>(sf::Vector2f(0.0f, 0.0f), 10.0f);
+        if (ballTexture.isValid()) {
+            ball->setTexture(AssetManager::getInstance()->getTexture(ballTexture));
+        }
+        spareBalls.push_back(std::move(ball));
+    }
+}
+
+void PlayState::subscribeSettings() {
+    Config& config = Config::getInstance();
+    
+    settingSubscriptions.push_back(config.subscribe(Settings::ballSpeed, [this](const float& speed) {
+        for (auto& ball : balls) {
+            ball->setSpeed(speed);
+        }
+    }));
+    
+    settingSubscriptions.push_back(config.subscribe(Settings::paddleSpeed, [this](const float& speed) {
+        if (paddle) {
+            paddle->setMaxSpeed(speed);
+        }
+    }));
+    
+    settingSubscriptions.push_back(config.subscribe(Settings::maxBalls, [this](const int&) {
+        loadRewardSettings();
+        reserveBalls();
+    }));
+    
+    settingSubscriptions.push_back(config.subscribe(Settings::ballSpawnChance, [this](const int&) {
+        loadRewardSettings();
+    }));
+    
+    settingSubscriptions.push_back(config.subscribe(Settings::autopilotSkill, [this](const float& skill) {
+        if (autopilot) {
+            autopilot->setSkill(skill);
+        }
+    }));
+    
+    settingSubscriptions.push_back(config.subscribe(Settings::autopilotReaction, [this](const float& seconds) {
+        if (autopilot) {
+            autopilot->setReactionDelay(seconds);
+        }
+    }));
 }
 
 Ball* PlayState::createNewBall(const sf::Vector2f& position, const sf::Vector2f& velocity) {
-    // 创建新球
-    auto newBall = std::make_unique<Ball>(position, 10.0f);
+    // 优先复用回收的球，游戏过程中生成新球不再分配
+    std::unique_ptr<Ball> newBall;
+    if (!spareBalls.empty()) {
+        newBall = std::move(spareBalls.back());
+        spareBalls.pop_back();
+        newBall->setActive(true);
+        newBall->setPosition(position);
+        newBall->setVelocity(sf::Vector2f(0.0f, 0.0f));
+        newBall->setSpeed(Config::getInstance().getSettings().ballSpeed);
+    } else {
+        newBall = std::make_unique<Ball>(position, 10.0f);
+    }
     
     // 设置球的速度
     newBall->setVelocity(velocity);
     
     // 设置球的纹理
-    if (AssetManager::getInstance()->hasTexture("ball")) {
-        newBall->setTexture(AssetManager::getInstance()->getTexture("ball"));
+    if (ballTexture.isValid()) {
+        newBall->setTexture(AssetManager::getInstance()->getTexture(ballTexture));
     }
     
     // 获取指针并添加到球列表中
@@ -600,6 +964,13 @@ Ball* PlayState::createNewBall(const sf::Vector2f& position, const sf::Vector2f&
     return ballPtr;
 }
 
+void PlayState::releaseAllBalls() {
+    for (auto& ball : balls) {
+        spareBalls.push_back(std::move(ball));
+    }
+    balls.clear();
+}
+
 void PlayState::trySpawnNewBall() {
     // 如果多球功能未启用，直接返回
     if (!multiballEnabled) {
@@ -612,12 +983,12 @@ void PlayState::trySpawnNewBall() {
     }
     
     // 根据概率决定是否生成新球
-    int randomValue = rand() % 100;
+    int randomValue = Utils::Random::getInt(0, 99);
     if (randomValue < ballSpawnChance) {
         // 如果有球存在，基于现有球生成新球
         if (!balls.empty()) {
             // 随机选择一个现有的球
-            size_t ballIndex = rand() % balls.size();
+            size_t ballIndex = static_cast<size_t>(Utils::Random::getInt(0, static_cast<int>(balls.size()) - 1));
             Ball* existingBall = balls[ballIndex].get();
             
             if (existingBall && existingBall->isActive()) {
@@ -626,11 +997,11 @@ void PlayState::trySpawnNewBall() {
                 sf::Vector2f velocity = existingBall->getVelocity();
                 
                 // 稍微调整新球的位置和速度方向
-                position.x += (rand() % 20) - 10;
-                position.y += (rand() % 20) - 10;
+                position.x += Utils::Random::getInt(-10, 9);
+                position.y += Utils::Random::getInt(-10, 9);
                 
                 // 计算新的速度向量（与原球方向略有不同）
-                float angle = (rand() % 60 - 30) * 3.14159f / 180.0f; // -30到30度的随机角度
+                float angle = Utils::Random::getInt(-30, 29) * 3.14159f / 180.0f; // -30到30度的随机角度
                 float speed = sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
                 
                 // 旋转速度向量
@@ -652,238 +1023,196 @@ void PlayState::trySpawnNewBall() {
     }
 }
 
-void PlayState::saveGameState() const {
-    // 使用Config类保存游戏状态
-    Config& config = Config::getInstance();
+void PlayState::saveGameState() {
+    TRACE_SCOPE("PlayState::saveGameState");
+    AllocTracker::TagScope tag(AllocTracker::Save);
+    
+    // 无尽模式和自动挡板不存档
+    if (endlessMode || autopilot) {
+        return;
+    }
     
-    // 保存游戏状态
-    config.setValue("save.score", score);
-    config.setValue("save.lives", lives);
-    config.setValue("save.level", levelManager.getCurrentLevel());
     GameState::currentLevel = levelManager.getCurrentLevel(); // 更新静态变量
-    config.setValue("save.ball_launched", ballLaunched);
     
-    // 保存挡板位置
+    // 主线程只拷贝状态，序列化和写盘交给后台存档服务
+    SaveSnapshot snapshot;
+    fillSnapshot(snapshot);
+    snapshot.generation = ++saveGeneration;
+    
+    const std::string& saveFile = Config::getInstance().getSettings().saveFile;
+    SaveService::getInstance()->submit(saveFile, [snapshot = std::move(snapshot)](std::vector<unsigned char>& out) {
+        snapshot.serialize(out);
+    });
+    
+    // 日志在存档之后重写；两者之间断电时日志仍是旧的代数，和新存档对不上，不会被回放
+    // （每局的代数起点是随机的，新一局的第一次整存也不会和上一局留下的日志同代）
+    journal.reset(saveGeneration);
+}
+
+void PlayState::fillSnapshot(SaveSnapshot& snapshot) const {
+    snapshot.score = score;
+    snapshot.lives = lives;
+    snapshot.level = levelManager.getCurrentLevel();
+    snapshot.ballLaunched = ballLaunched;
+    snapshot.rngState = Utils::Random::getState();
+    
     if (paddle) {
-        config.setValue("save.paddle_x", paddle->getPosition().x);
-        config.setValue("save.paddle_y", paddle->getPosition().y);
+        snapshot.paddleX = paddle->getPosition().x;
+        snapshot.paddleY = paddle->getPosition().y;
     }
     
-    // 保存球的数量和位置
-    config.setValue("save.ball_count", static_cast<int>(balls.size()));
-    for (size_t i = 0; i < balls.size() && i < 10; ++i) { // 最多保存10个球
-        if (balls[i]) {
-            std::string prefix = "save.ball" + std::to_string(i) + "_";
-            config.setValue(prefix + "x", balls[i]->getPosition().x);
-            config.setValue(prefix + "y", balls[i]->getPosition().y);
-            config.setValue(prefix + "vx", balls[i]->getVelocity().x);
-            config.setValue(prefix + "vy", balls[i]->getVelocity().y);
+    snapshot.balls.clear();
+    snapshot.balls.reserve(balls.size());
+    for (const auto& ball : balls) {
+        if (ball) {
+            snapshot.balls.push_back({ball->getPosition().x, ball->getPosition().y,
+                                      ball->getVelocity().x, ball->getVelocity().y});
         }
     }
     
-    // 保存砖块状态
-    config.setValue("save.brick_count", static_cast<int>(bricks.size()));
-    for (size_t i = 0; i < bricks.size() && i < 100; ++i) { // 最多保存100个砖块
-        if (bricks[i]) {
-            std::string prefix = "save.brick" + std::to_string(i) + "_";
-            config.setValue(prefix + "active", bricks[i]->isActive());
+    snapshot.setBrickCount(static_cast<std::uint32_t>(bricks.size()));
+    for (std::size_t i = 0; i < bricks.size(); ++i) {
+        if (bricks[i]->isActive()) {
+            snapshot.setBrickActive(static_cast<std::uint32_t>(i), true);
         }
     }
+}
+
+bool PlayState::loadGameState() {
+    SaveSnapshot snapshot;
+    const std::string& saveFile = Config::getInstance().getSettings().saveFile;
+    if (!snapshot.loadFromFile(saveFile)) {
+        LOG_INFO(Save, "Save file does not exist or failed to load, creating new game");
+        return false;
+    }
+    
+    if (snapshot.level < 0 || snapshot.level >= levelManager.getTotalLevels() || snapshot.lives <= 0) {
+        LOG_WARN(Save, "Save file has invalid state, creating new game");
+        return false;
+    }
     
-    // 验证要保存的数据
-    std::cout << "Verifying save data before writing..." << std::endl;
-    std::cout << "Score: " << score << std::endl;
-    std::cout << "Lives: " << lives << std::endl;
-    std::cout << "Level: " << levelManager.getCurrentLevel() << std::endl;
-    std::cout << "Ball count: " << balls.size() << std::endl;
+    // 继续这个存档时代数接着往上加
+    saveGeneration = snapshot.generation;
     
-    if (paddle) {
-        std::cout << "Paddle position: (" << paddle->getPosition().x << ", " 
-                  << paddle->getPosition().y << ")" << std::endl;
-    } else {
-        std::cerr << "Warning: Paddle is null when saving game state" << std::endl;
+    applySnapshot(snapshot);
+    
+    // 回放上次整存之后的增量
+    std::vector<JournalFormat::Record> records;
+    const std::string& journalFile = Config::getInstance().getSettings().saveJournalFile;
+    if (SaveJournal::load(journalFile, snapshot.generation, records)) {
+        replayJournal(records);
     }
     
-    // 保存到文件
-    std::cout << "Attempting to save game state to save.ini..." << std::endl;
-    std::cout << "Current path: " << std::filesystem::current_path().string() << std::endl;
+    if (lives <= 0) {
+        LOG_INFO(Save, "Saved game was already over, creating new game");
+        return false;
+    }
     
-    bool saved = config.save("save.ini");
-    if (saved) {
-        std::cout << "Game state successfully saved to save.ini" << std::endl;
-        
-        // 验证文件是否确实创建
-        std::ifstream checkFile("save.ini");
-        if (checkFile.good()) {
-            std::cout << "Verified: save.ini exists and is readable" << std::endl;
-            
-            // 读取文件内容进行验证
-            std::string line;
-            int lineCount = 0;
-            while (std::getline(checkFile, line) && lineCount < 10) {
-                std::cout << "save.ini line " << lineCount << ": " << line << std::endl;
-                lineCount++;
-            }
-            
-            checkFile.close();
-        } else {
-            std::cerr << "Warning: save.ini was reported as saved but cannot be opened for reading" << std::endl;
+    LOG_DEBUG(Save, "Save file loaded");
+    return true;
+}
+
+void PlayState::replayJournal(const std::vector<JournalFormat::Record>& records) {
+    for (const auto& record : records) {
+        switch (record.type) {
+            case JournalFormat::BrickDestroyed:
+                if (record.value >= 0 && static_cast<std::size_t>(record.value) < bricks.size()) {
+                    bricks[record.value]->setActive(false);
+                }
+                break;
+            case JournalFormat::ScoreDelta:
+                score += record.value;
+                break;
+            case JournalFormat::LifeLost:
+                lives = record.value;
+                break;
+            case JournalFormat::LevelChange:
+                if (record.value >= 0 && record.value < levelManager.getTotalLevels()) {
+                    GameState::currentLevel = record.value;
+                    loadLevel(record.value);
+                    lives = Config::getInstance().getSettings().initialLives;
+                }
+                break;
+            default:
+                break;
         }
-    } else {
-        std::cerr << "Failed to save game state to save.ini" << std::endl;
     }
+    
+    // 日志不记录球的位置，有增量时从挡板上重新发球
+    if (!records.empty()) {
+        resetBallAndPaddle();
+        updateUI();
+    }
+    LOG_INFO(Save, "Replayed %zu journal records", records.size());
 }
 
-bool PlayState::loadGameState() {
-    try {
-        // 尝试加载存档文件
-        Config& config = Config::getInstance();
-        
-        // 检查save.ini文件是否存在
-        std::ifstream checkFile("save.ini");
-        if (!checkFile.good() || !config.load("save.ini")) {
-            std::cout << "Save file does not exist or failed to load, creating new game" << std::endl;
-            return false; // 加载失败
-        }
-        
-        // 检查存档文件是否包含必要的数据
-        if (!config.hasValue("save.level") || !config.hasValue("save.lives")) {
-            std::cout << "Save file incomplete, creating new game" << std::endl;
-            return false;
-        }
-        
-        // 加载基本游戏状态
-        score = config.getValue("save.score", 0);
-        lives = config.getValue("save.lives", 3);
-        GameState::currentLevel = config.getValue("save.level", 0);
-        ballLaunched = config.getValue("save.ball_launched", false);
-        
-        // 加载关卡
-        loadLevel(GameState::currentLevel);
-        
-        // 设置挡板位置
-        float paddleX = 0.0f, paddleY = 0.0f;
-        try {
-            paddleX = config.getValue("save.paddle_x", 350.0f);
-            paddleY = config.getValue("save.paddle_y", 450.0f);
-            std::cout << "Paddle position from save: (" << paddleX << ", " << paddleY << ")" << std::endl;
-        }
-        catch (const std::exception& e) {
-            std::cerr << "Error loading paddle position: " << e.what() << std::endl;
-            // 使用默认值
-            sf::Vector2u windowSize = game->getWindow().getSize();
-            paddleX = (windowSize.x - 100.0f) / 2.0f;
-            paddleY = windowSize.y - 50.0f;
-        }
-        
-        // 检查位置是否有效
-        sf::Vector2u windowSize = game->getWindow().getSize();
-        if (paddleX < 0 || paddleX > windowSize.x || paddleY < 0 || paddleY > windowSize.y) {
-            std::cout << "Paddle position out of bounds, using default position" << std::endl;
-            paddleX = (windowSize.x - 100.0f) / 2.0f;
-            paddleY = windowSize.y - 50.0f;
-        }
-        
-        if (paddle) {
-            paddle->setPosition(sf::Vector2f(paddleX, paddleY));
-        } else {
-            std::cerr << "Error: Paddle is null when trying to set position" << std::endl;
-            // 创建新的挡板
-            paddle = std::make_unique<Paddle>(
-                sf::Vector2f(paddleX, paddleY),
-                sf::Vector2f(100.0f, 20.0f)
-            );
-            paddle->setWindowWidth(static_cast<float>(windowSize.x));
-            paddle->setMaxSpeed(Config::getInstance().getValue("game.paddle_speed", 500.0f));
-            if (AssetManager::getInstance()->hasTexture("paddle")) {
-                paddle->setTexture(AssetManager::getInstance()->getTexture("paddle"));
-            }
-        }
-        
-        // 清空现有的球
-        balls.clear();
-        
-        // 加载球
-        int ballCount = config.getValue("save.ball_count", 0);
-        std::cout << "Loading " << ballCount << " balls from save file" << std::endl;
-        
-        // 确保至少有一个球
-        if (ballCount <= 0) {
-            ballCount = 1;
-            std::cout << "No balls found in save file, creating default ball" << std::endl;
-        }
-        
-        for (int i = 0; i < ballCount && i < 10; ++i) {
-            std::string prefix = "save.ball" + std::to_string(i) + "_";
-            
-            // 获取球的位置和速度，如果出错则使用默认值
-            float x = 0.0f, y = 0.0f, vx = 0.0f, vy = 0.0f;
-            try {
-                x = config.getValue(prefix + "x", 400.0f);
-                y = config.getValue(prefix + "y", 300.0f);
-                vx = config.getValue(prefix + "vx", 0.0f);
-                vy = config.getValue(prefix + "vy", 0.0f);
-                
-                std::cout << "Ball " << i << " position: (" << x << ", " << y 
-                          << "), velocity: (" << vx << ", " << vy << ")" << std::endl;
-            }
-            catch (const std::exception& e) {
-                std::cerr << "Error loading ball " << i << ": " << e.what() << std::endl;
-                // 使用默认值
-                x = 400.0f;
-                y = 300.0f;
-                vx = 0.0f;
-                vy = 0.0f;
-            }
-            
-            // 检查位置是否有效
-            sf::Vector2u windowSize = game->getWindow().getSize();
-            if (x < 0 || x > windowSize.x || y < 0 || y > windowSize.y) {
-                std::cout << "Ball " << i << " position out of bounds, using default position" << std::endl;
-                x = windowSize.x / 2.0f;
-                y = windowSize.y - 80.0f;
-            }
-            
-            createNewBall(sf::Vector2f(x, y), sf::Vector2f(vx, vy));
-        }
-        
-        // 如果没有球，创建一个默认的球
-        if (balls.empty()) {
-            sf::Vector2u windowSize = game->getWindow().getSize();
-            createNewBall(
-                sf::Vector2f(windowSize.x / 2.0f - 10.0f, windowSize.y - 80.0f),
-                sf::Vector2f(0.0f, 0.0f)
-            );
+void PlayState::applySnapshot(const SaveSnapshot& snapshot) {
+    sf::Vector2u windowSize = game->getSize();
+    
+    // 加载基本游戏状态
+    score = snapshot.score;
+    lives = snapshot.lives;
+    GameState::currentLevel = snapshot.level;
+    ballLaunched = snapshot.ballLaunched;
+    Utils::Random::setState(snapshot.rngState);
+    
+    // 加载关卡
+    loadLevel(GameState::currentLevel);
+    
+    // 设置挡板位置，越界时使用默认位置
+    float paddleX = snapshot.paddleX;
+    float paddleY = snapshot.paddleY;
+    if (paddleX < 0 || paddleX > windowSize.x || paddleY < 0 || paddleY > windowSize.y) {
+        LOG_WARN(Save, "Paddle position out of bounds, using default position");
+        paddleX = (windowSize.x - 100.0f) / 2.0f;
+        paddleY = windowSize.y - 50.0f;
+    }
+    
+    if (paddle) {
+        paddle->setPosition(sf::Vector2f(paddleX, paddleY));
+    } else {
+        // 创建新的挡板
+        paddle = std::make_unique<Paddle>(
+            sf::Vector2f(paddleX, paddleY),
+            sf::Vector2f(100.0f, 20.0f)
+        );
+        paddle->setWindowWidth(static_cast<float>(windowSize.x));
+        paddle->setMaxSpeed(Config::getInstance().getSettings().paddleSpeed);
+        if (paddleTexture.isValid()) {
+            paddle->setTexture(AssetManager::getInstance()->getTexture(paddleTexture));
         }
-        
-        // 加载砖块状态
-        int brickCount = config.getValue("save.brick_count", 0);
-        if (brickCount > 0 && !bricks.empty()) {
-            for (int i = 0; i < brickCount && i < 100 && i < bricks.size(); ++i) {
-                std::string prefix = "save.brick" + std::to_string(i) + "_";
-                bool active = config.getValue(prefix + "active", true);
-                if (bricks[i] && !active) {
-                    bricks[i]->setActive(false);
-                }
-            }
+    }
+    
+    // 加载球，越界的球放回挡板上方
+    releaseAllBalls();
+    for (const auto& record : snapshot.balls) {
+        sf::Vector2f position(record.x, record.y);
+        if (position.x < 0 || position.x > windowSize.x || position.y < 0 || position.y > windowSize.y) {
+            position = sf::Vector2f(windowSize.x / 2.0f, windowSize.y - 80.0f);
         }
-        
-        // 更新UI
-        updateUI();
-        
-        std::cout << "Save file loaded successfully!" << std::endl;
-        return true;
-    }
-    catch (const std::exception& e) {
-        std::cerr << "Exception while loading save file: " << e.what() << std::endl;
-        // 如果加载过程中出错，重置游戏状态
-        balls.clear();
-        sf::Vector2u windowSize = game->getWindow().getSize();
+        createNewBall(position, sf::Vector2f(record.vx, record.vy));
+    }
+    
+    // 如果没有球，创建一个默认的球
+    if (balls.empty()) {
         createNewBall(
             sf::Vector2f(windowSize.x / 2.0f - 10.0f, windowSize.y - 80.0f),
             sf::Vector2f(0.0f, 0.0f)
         );
-        return false;
+        ballLaunched = false;
     }
+    
+    // 加载砖块状态（关卡文件改动过时砖块数对不上，保留完整关卡）
+    if (snapshot.brickCount == bricks.size()) {
+        for (std::uint32_t i = 0; i < snapshot.brickCount; ++i) {
+            if (!snapshot.isBrickActive(i)) {
+                bricks[i]->setActive(false);
+            }
+        }
+    } else {
+        LOG_WARN(Save, "Saved brick count does not match level, keeping all bricks");
+    }
+    
+    // 更新UI
+    updateUI();
 }
-
@@ -0,0 +1,165 @@
+#include "Utils/AllocTracker.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// Static member initialization
+std::atomic<std::uint64_t> AllocTracker::allocationCounts[AllocTracker::TagCount] = {};
+std::atomic<std::uint64_t> AllocTracker::byteCounts[AllocTracker::TagCount] = {};
+thread_local AllocTracker::Tag AllocTracker::currentTag = AllocTracker::Other; // 主线程在 Game::run 中切到 General
+AllocTracker::FrameStats AllocTracker::lastFrame = {};
+AllocTracker::Counts AllocTracker::frameStart[AllocTracker::TagCount] = {};
+bool AllocTracker::guardEnabled = false;
+int AllocTracker::warmupFrames = 0;
+bool AllocTracker::steadyFrame = false;
+std::uint64_t AllocTracker::violations = 0;
+
+namespace {
+    const char* const tagNames[AllocTracker::TagCount] = {
+        "general", "play", "collision", "ui", "save", "debug", "other"
+    };
+}
+
+bool AllocTracker::isAvailable() {
+#ifdef BRICKBREAKER_ALLOC_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AllocTracker::endFrame() {
+    FrameStats stats = {};
+    for (int tag = 0; tag < TagCount; ++tag) {
+        Counts now = {allocationCounts[tag].load(std::memory_order_relaxed), byteCounts[tag].load(std::memory_order_relaxed)};
+        stats.tags[tag] = {now.allocations - frameStart[tag].allocations, now.bytes - frameStart[tag].bytes};
+        stats.total.allocations += stats.tags[tag].allocations;
+        stats.total.bytes += stats.tags[tag].bytes;
+        frameStart[tag] = now;
+    }
+    lastFrame = stats;
+    
+    const bool steady = steadyFrame;
+    steadyFrame = false;
+    if (!guardEnabled || !steady) {
+        return;
+    }
+    if (warmupFrames > 0) {
+        --warmupFrames;
+        return;
+    }
+    
+    // 这里只用 printf：报告本身不能再分配
+    bool violated = false;
+    for (int tag = 0; tag < TagCount; ++tag) {
+        if (isGuarded(static_cast<Tag>(tag)) && stats.tags[tag].allocations > 0) {
+            if (!violated) {
+                std::fprintf(stderr, "Steady-state allocation in frame:");
+                violated = true;
+            }
+            std::fprintf(stderr, " %s %llu (%llu B)", tagNames[tag],
+                         static_cast<unsigned long long>(stats.tags[tag].allocations),
+                         static_cast<unsigned long long>(stats.tags[tag].bytes));
+        }
+    }
+    if (violated) {
+        std::fprintf(stderr, "\n");
+        ++violations;
+    }
+}
+
+void AllocTracker::setGuard(bool enabled, int warmup) {
+    guardEnabled = enabled;
+    warmupFrames = warmup;
+    steadyFrame = false;
+    violations = 0;
+}
+
+const char* AllocTracker::tagName(Tag tag) {
+    return tag < TagCount ? tagNames[tag] : "unknown";
+}
+
+#ifdef BRICKBREAKER_ALLOC_TRACKING
+// 替换全局分配函数：统计后交给 malloc
+void* operator new(std::size_t size) {
+    AllocTracker::onAllocate(size);
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    AllocTracker::onAllocate(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return ::operator new(size, std::nothrow);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+
+// 对齐分配
+namespace {
+    void* alignedAllocate(std::size_t size, std::align_val_t alignment) {
+        const std::size_t align = static_cast<std::size_t>(alignment);
+        // aligned_alloc 要求大小是对齐的整数倍
+        size = (size + align - 1) / align * align;
+#ifdef _WIN32
+        return _aligned_malloc(size ? size : align, align);
+#else
+        return std::aligned_alloc(align, size ? size : align);
+#endif
+    }
+    
+    void alignedFree(void* memory) {
+#ifdef _WIN32
+        _aligned_free(memory);
+#else
+        std::free(memory);
+#endif
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    AllocTracker::onAllocate(size);
+    if (void* memory = alignedAllocate(size, alignment)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    AllocTracker::onAllocate(size);
+    return alignedAllocate(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return ::operator new(size, alignment, std::nothrow);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept { alignedFree(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { alignedFree(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { alignedFree(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { alignedFree(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { alignedFree(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { alignedFree(memory); }
+#endif
@@ -1,14 +1,212 @@
 #include "Utils/Config.h"
+#include "Utils/MappedFile.h"
+#include "Utils/SaveService.h"
+#include "Utils/Logger.h"
 #include <algorithm>
-#include <cctype>
-#include <regex>
-#include <cerrno>
+#include <charconv>
+#include <cstdlib>
 #include <cstring>
+#include <sstream>
+#include <variant>
+#include <vector>
 
 // 初始化静态成员
 std::unique_ptr<Config> Config::instance = nullptr;
 
-Config::Config() : configFilePath("config.ini") {
+namespace {
+    // 配置表中的一项：键名和 GameSettings 中的字段
+    using SettingSlot = std::variant<int GameSettings::*, float GameSettings::*, bool GameSettings::*,
+                                     std::string GameSettings::*, sf::Color GameSettings::*>;
+    
+    struct SettingField {
+        std::string_view key;
+        SettingSlot slot;
+    };
+    
+    // 按键名排序的配置表，键名的前缀就是分区，排序后同一分区的项连在一起
+    const std::vector<SettingField>& settingTable() {
+        static const std::vector<SettingField> table = [] {
+            std::vector<SettingField> fields = {
+#define BRICKBREAKER_SETTING_FIELD(type, member, key, value) {key, &GameSettings::member},
+                BRICKBREAKER_SETTINGS(BRICKBREAKER_SETTING_FIELD)
+#undef BRICKBREAKER_SETTING_FIELD
+            };
+            std::sort(fields.begin(), fields.end(),
+                      [](const SettingField& a, const SettingField& b) { return a.key < b.key; });
+            return fields;
+        }();
+        return table;
+    }
+    
+    const SettingField* findSetting(std::string_view key) {
+        const auto& table = settingTable();
+        auto it = std::lower_bound(table.begin(), table.end(), key,
+                                   [](const SettingField& field, std::string_view k) { return field.key < k; });
+        return (it != table.end() && it->key == key) ? &*it : nullptr;
+    }
+    
+    std::string_view trim(std::string_view text) {
+        const std::size_t first = text.find_first_not_of(" \t\r");
+        if (first == std::string_view::npos) {
+            return {};
+        }
+        return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+    }
+    
+    // 以下解析函数都要求整个字符串都被消耗，失败时不修改输出
+    bool parseValue(std::string_view text, float& out) {
+        // strtof 需要以 0 结尾，数字都很短，拷到栈上
+        char buffer[64];
+        if (text.empty() || text.size() >= sizeof(buffer)) {
+            return false;
+        }
+        std::memcpy(buffer, text.data(), text.size());
+        buffer[text.size()] = '\0';
+        
+        char* end = nullptr;
+        float value = std::strtof(buffer, &end);
+        if (end != buffer + text.size()) {
+            return false;
+        }
+        out = value;
+        return true;
+    }
+    
+    bool parseValue(std::string_view text, int& out) {
+        int value = 0;
+        auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (result.ec == std::errc() && result.ptr == text.data() + text.size()) {
+            out = value;
+            return true;
+        }
+        
+        // 整数项写成了 "400.0" 之类
+        float floatValue;
+        if (parseValue(text, floatValue)) {
+            out = static_cast<int>(floatValue);
+            return true;
+        }
+        return false;
+    }
+    
+    bool parseValue(std::string_view text, bool& out) {
+        if (text == "true" || text == "1") {
+            out = true;
+            return true;
+        }
+        if (text == "false" || text == "0") {
+            out = false;
+            return true;
+        }
+        return false;
+    }
+    
+    bool parseValue(std::string_view text, std::string& out) {
+        out.assign(text.data(), text.size());
+        return true;
+    }
+    
+    // 逗号分隔的数字，返回分量个数（最多 maxCount 个），格式不对时返回0
+    template<typename T>
+    int parseList(std::string_view text, T* out, int maxCount) {
+        int count = 0;
+        while (count < maxCount) {
+            const std::size_t comma = text.find(',');
+            if (!parseValue(trim(text.substr(0, comma)), out[count])) {
+                return 0;
+            }
+            ++count;
+            if (comma == std::string_view::npos) {
+                return count;
+            }
+            text.remove_prefix(comma + 1);
+        }
+        return 0; // 分量太多
+    }
+    
+    bool parseValue(std::string_view text, sf::Color& out) {
+        int components[4] = {0, 0, 0, 255};
+        const int count = parseList(text, components, 4);
+        if (count < 3) {
+            return false;
+        }
+        out = sf::Color(static_cast<std::uint8_t>(components[0]), static_cast<std::uint8_t>(components[1]),
+                        static_cast<std::uint8_t>(components[2]), static_cast<std::uint8_t>(components[3]));
+        return true;
+    }
+    
+    // 配置表之外的项：file 分区固定为字符串，其余按值的形式推断
+    std::any inferValue(std::string_view key, std::string_view text) {
+        if (key.substr(0, 5) == "file.") {
+            return std::string(text);
+        }
+        
+        if (text == "true" || text == "false") {
+            return text == "true";
+        }
+        
+        if (text.find(',') != std::string_view::npos) {
+            float components[4];
+            const int count = parseList(text, components, 4);
+            if (count == 2) {
+                return sf::Vector2f(components[0], components[1]);
+            }
+            sf::Color color;
+            if (count >= 3 && parseValue(text, color)) {
+                return color;
+            }
+            return std::string(text);
+        }
+        
+        int intValue;
+        auto result = std::from_chars(text.data(), text.data() + text.size(), intValue);
+        if (result.ec == std::errc() && result.ptr == text.data() + text.size()) {
+            return intValue;
+        }
+        
+        float floatValue;
+        if (parseValue(text, floatValue)) {
+            return floatValue;
+        }
+        return std::string(text);
+    }
+    
+    void writeValue(std::ostream& file, int value) { file << value; }
+    void writeValue(std::ostream& file, float value) { file << value; }
+    void writeValue(std::ostream& file, bool value) { file << (value ? "true" : "false"); }
+    void writeValue(std::ostream& file, const std::string& value) { file << value; }
+    
+    void writeValue(std::ostream& file, const sf::Color& color) {
+        file << static_cast<int>(color.r) << ","
+             << static_cast<int>(color.g) << ","
+             << static_cast<int>(color.b) << ","
+             << static_cast<int>(color.a);
+    }
+    
+    void writeAny(std::ostream& file, const std::any& value) {
+        if (const auto* s = std::any_cast<std::string>(&value)) {
+            writeValue(file, *s);
+        } else if (const auto* i = std::any_cast<int>(&value)) {
+            writeValue(file, *i);
+        } else if (const auto* f = std::any_cast<float>(&value)) {
+            writeValue(file, *f);
+        } else if (const auto* d = std::any_cast<double>(&value)) {
+            file << *d;
+        } else if (const auto* b = std::any_cast<bool>(&value)) {
+            writeValue(file, *b);
+        } else if (const auto* vec = std::any_cast<sf::Vector2f>(&value)) {
+            file << vec->x << "," << vec->y;
+        } else if (const auto* color = std::any_cast<sf::Color>(&value)) {
+            writeValue(file, *color);
+        } else if (const auto* key = std::any_cast<sf::Keyboard::Key>(&value)) {
+            file << static_cast<int>(*key);
+        } else {
+            file << "unknown type";
+        }
+    }
+}
+
+Config::Config() : nextSubscriberId(1), notifyDepth(0), configFilePath("config.ini") {
     initDefaults();
 }
 
@@ -20,45 +218,21 @@ Config& Config::getInstance() {
 }
 
 void Config::initDefaults() {
-    // 窗口设置
-    setValue("window.title", std::string("BrickBreaker"));
-    setValue("window.width", 800);
-    setValue("window.height", 600);
-    setValue("window.fullscreen", false);
-    setValue("window.vsync", true);
-    setValue("window.framerate_limit", 60);
-    
-    // 游戏设置
-    setValue("game.ball_speed", 300.0f);
-    setValue("game.paddle_speed", 50.0f);
-    setValue("game.initial_lives", 10);
-    setValue("game.brick_rows", 5);
-    setValue("game.brick_columns", 10);
-    
-    // 奖励机制设置
-    setValue("reward.max_balls", 3);
-    setValue("reward.ball_spawn_chance", 30);
-    
-    // 颜色设置
-    setValue("colors.background", sf::Color(20, 20, 50));
-    setValue("colors.ball", sf::Color::White);
-    setValue("colors.paddle", sf::Color::White);
-    setValue("colors.brick1", sf::Color::Red);
-    setValue("colors.brick2", sf::Color::Yellow);
-    setValue("colors.brick3", sf::Color::Green);
-    setValue("colors.brick4", sf::Color::Blue);
-    setValue("colors.brick5", sf::Color(128, 0, 128)); // 紫色
-    
-    // 音效设置
-    setValue("sound.enabled", true);
-    setValue("sound.volume", 100.0f);
-    setValue("sound.music_volume", 80.0f);
-    
-    // 控制设置 - 使用SFML 3.0.0的枚举值
-    setValue("controls.move_left", static_cast<int>(sf::Keyboard::Key::Left));
-    setValue("controls.move_right", static_cast<int>(sf::Keyboard::Key::Right));
-    setValue("controls.launch", static_cast<int>(sf::Keyboard::Key::Space));
-    setValue("controls.pause", static_cast<int>(sf::Keyboard::Key::P));
+    // 默认值全部来自配置表（GameSettings.h）
+    settings = GameSettings{};
+    publish();
+}
+
+const GameSettings& Config::getSettings() const {
+    return settings;
+}
+
+std::shared_ptr<const GameSettings> Config::getSnapshot() const {
+    return std::atomic_load(&snapshot);
+}
+
+void Config::publish() {
+    std::atomic_store(&snapshot, std::shared_ptr<const GameSettings>(std::make_shared<GameSettings>(settings)));
 }
 
 bool Config::load(const std::string& filename) {
@@ -72,308 +246,245 @@ bool Config::save(const std::string& filename) const {
 }
 
 bool Config::loadFromFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "cannot open config file: " << filename << std::endl;
+    MappedFile file;
+    if (!file.open(filename)) {
+        LOG_ERROR(Config, "Cannot open config file: %s", filename.c_str());
         return false;
     }
     
-    std::string line;
-    while (std::getline(file, line)) {
-        // 跳过空行和注释行
-        if (line.empty() || line[0] == '#' || line[0] == ';') {
-            continue;
-        }
-        
-        parseLine(line);
-    }
+    GameSettings next = settings;
+    parseBuffer(reinterpret_cast<const char*>(file.getData()), file.getSize(), next, &extras);
+    applySettings(next);
     
-    file.close();
-    std::cout << "load config file successfully: " << filename << std::endl;
+    LOG_INFO(Config, "Loaded config file: %s", filename.c_str());
     return true;
 }
 
-bool Config::saveToFile(const std::string& filename) const {
-    std::ofstream file(filename, std::ios::out | std::ios::trunc);
-    if (!file.is_open()) {
-        std::cerr << "cannot create config file: " << filename << std::endl;
-        std::cerr << "Error: " << std::strerror(errno) << std::endl;
+bool Config::parseSettingsFile(const std::string& filename, GameSettings& target) {
+    MappedFile file;
+    if (!file.open(filename)) {
         return false;
     }
-    
-    file << "# config file for BrickBreaker\n";
-    file << "# automatically generated, do not modify manually\n\n";
-    
-    // 按类别组织配置项
-    // 窗口设置
-    file << "# window settings\n";
-    for (const auto& pair : values) {
-        if (pair.first.find("window.") == 0) {
-            writeConfigValue(file, pair.first, pair.second);
+    parseBuffer(reinterpret_cast<const char*>(file.getData()), file.getSize(), target, nullptr);
+    return true;
+}
+
+void Config::parseBuffer(const char* data, std::size_t size, GameSettings& target, ExtraMap* extraTarget) {
+    const char* end = data + size;
+    while (data < end) {
+        const char* newline = static_cast<const char*>(std::memchr(data, '\n', static_cast<std::size_t>(end - data)));
+        const char* lineEnd = newline ? newline : end;
+        std::string_view line = trim(std::string_view(data, static_cast<std::size_t>(lineEnd - data)));
+        data = newline ? newline + 1 : end;
+        
+        // 跳过空行、注释行和 [分区] 行（分区由键名前缀决定）
+        if (line.empty() || line[0] == '#' || line[0] == ';' || line[0] == '[') {
+            continue;
         }
-    }
-    file << "\n";
-    
-    // 游戏设置
-    file << "# game settings\n";
-    for (const auto& pair : values) {
-        if (pair.first.find("game.") == 0) {
-            writeConfigValue(file, pair.first, pair.second);
+        
+        // 没有等号，跳过这一行
+        const std::size_t equalsPos = line.find('=');
+        if (equalsPos == std::string_view::npos) {
+            continue;
         }
+        
+        parseEntry(trim(line.substr(0, equalsPos)), trim(line.substr(equalsPos + 1)), target, extraTarget);
     }
-    file << "\n";
-    
-    // 颜色设置
-    file << "# color settings\n";
-    for (const auto& pair : values) {
-        if (pair.first.find("colors.") == 0) {
-            writeConfigValue(file, pair.first, pair.second);
-        }
+}
+
+void Config::parseEntry(std::string_view key, std::string_view value, GameSettings& target, ExtraMap* extraTarget) {
+    if (key.empty()) {
+        return;
     }
-    file << "\n";
     
-    // 音效设置
-    file << "# sound settings\n";
-    for (const auto& pair : values) {
-        if (pair.first.find("sound.") == 0) {
-            writeConfigValue(file, pair.first, pair.second);
+    // 配置表中的项直接解析进字段
+    if (const SettingField* field = findSetting(key)) {
+        bool ok = std::visit([&target, value](auto slot) { return parseValue(value, target.*slot); }, field->slot);
+        if (!ok) {
+            LOG_WARN(Config, "Config parse error: %.*s = %.*s", static_cast<int>(key.size()), key.data(),
+                     static_cast<int>(value.size()), value.data());
         }
+        return;
     }
-    file << "\n";
     
-    // 控制设置
-    file << "# control settings\n";
-    for (const auto& pair : values) {
-        if (pair.first.find("controls.") == 0) {
-            writeConfigValue(file, pair.first, pair.second);
-        }
+    if (!extraTarget) {
+        return;
     }
-    file << "\n";
     
-    // 其他设置
-    bool hasOthers = false;
-    for (const auto& pair : values) {
-        if (pair.first.find("window.") != 0 && 
-            pair.first.find("game.") != 0 && 
-            pair.first.find("colors.") != 0 && 
-            pair.first.find("sound.") != 0 && 
-            pair.first.find("controls.") != 0) {
-            
-            if (!hasOthers) {
-                file << "# other settings\n";
-                hasOthers = true;
-            }
-            
-            writeConfigValue(file, pair.first, pair.second);
-        }
+    std::any parsed = inferValue(key, value);
+    auto it = extraTarget->find(key);
+    if (it != extraTarget->end()) {
+        it->second = std::move(parsed);
+    } else {
+        extraTarget->emplace(std::string(key), std::move(parsed));
     }
-    
-    file.close();
-    std::cout << "save config file successfully: " << filename << std::endl;
-    return true;
 }
 
-// 辅助函数，用于将配置值写入文件
-void Config::writeConfigValue(std::ofstream& file, const std::string& key, const std::any& value) const {
-    file << key << " = ";
+bool Config::saveToFile(const std::string& filename) const {
+    std::ostringstream text;
+    writeConfig(text);
+    std::string contents = text.str();
     
-    // 处理不同类型的值
-    try {
-        if (value.type() == typeid(std::string)) {
-            file << std::any_cast<std::string>(value);
-        } else if (value.type() == typeid(int)) {
-            file << std::any_cast<int>(value);
-        } else if (value.type() == typeid(float)) {
-            file << std::any_cast<float>(value);
-        } else if (value.type() == typeid(double)) {
-            file << std::any_cast<double>(value);
-        } else if (value.type() == typeid(bool)) {
-            file << (std::any_cast<bool>(value) ? "true" : "false");
-        } else if (value.type() == typeid(sf::Vector2f)) {
-            const auto& vec = std::any_cast<sf::Vector2f>(value);
-            file << vec.x << "," << vec.y;
-        } else if (value.type() == typeid(sf::Color)) {
-            const auto& color = std::any_cast<sf::Color>(value);
-            file << static_cast<int>(color.r) << "," 
-                 << static_cast<int>(color.g) << "," 
-                 << static_cast<int>(color.b) << "," 
-                 << static_cast<int>(color.a);
-        } else if (value.type() == typeid(sf::Keyboard::Key)) {
-            file << static_cast<int>(std::any_cast<sf::Keyboard::Key>(value));
-        } else {
-            file << "unknown type";
-        }
-    } catch (const std::bad_any_cast&) {
-        file << "type error";
+    if (!SaveService::writeAtomically(filename, contents.data(), contents.size())) {
+        LOG_ERROR(Config, "Cannot create config file: %s", filename.c_str());
+        return false;
     }
     
-    file << "\n";
+    LOG_INFO(Config, "Saved config file: %s", filename.c_str());
+    return true;
 }
 
-void Config::parseLine(const std::string& line) {
-    // 查找等号分隔符
-    size_t equalsPos = line.find('=');
-    if (equalsPos == std::string::npos) {
-        return; // 没有等号，跳过这一行
-    }
+void Config::saveAsync(const std::string& filename) const {
+    std::string path = filename.empty() ? configFilePath : filename;
     
-    // 提取键和值
-    std::string key = line.substr(0, equalsPos);
-    std::string valueStr = line.substr(equalsPos + 1);
+    std::ostringstream text;
+    writeConfig(text);
+    SaveService::getInstance()->submit(path, [contents = text.str()](std::vector<unsigned char>& out) {
+        out.assign(contents.begin(), contents.end());
+    });
+}
+
+void Config::writeConfig(std::ostream& file) const {
+    file << "# config file for BrickBreaker\n";
+    file << "# automatically generated, do not modify manually\n";
     
-    // 去除前后空格
-    key.erase(0, key.find_first_not_of(" \t"));
-    key.erase(key.find_last_not_of(" \t") + 1);
-    valueStr.erase(0, valueStr.find_first_not_of(" \t"));
-    valueStr.erase(valueStr.find_last_not_of(" \t") + 1);
+    // 配置表和其余项都按键名排好序，归并着一次写完，分区变化时写分区注释
+    const auto& table = settingTable();
+    auto field = table.begin();
+    auto extra = extras.begin();
+    std::string_view section;
     
-    // 确定值的类型并存储
-    if (key.find("window.title") == 0 || key.find("file.") == 0) {
-        // 字符串类型
-        setValue(key, valueStr);
-    } else if (valueStr == "true" || valueStr == "false") {
-        // 布尔类型
-        setValue(key, valueStr == "true");
-    } else if (valueStr.find(',') != std::string::npos) {
-        // 可能是Vector2f或Color
-        if (std::count(valueStr.begin(), valueStr.end(), ',') == 1) {
-            // Vector2f
-            setValue(key, convertVector2f(valueStr));
-        } else if (std::count(valueStr.begin(), valueStr.end(), ',') == 3) {
-            // Color
-            setValue(key, convertColor(valueStr));
-        }
-    } else if (key.find("save.paddle_x") == 0 || 
-               key.find("save.paddle_y") == 0 || 
-               key.find("save.ball") != std::string::npos) {
-        // 这些键应该总是被解析为浮点数
-        try {
-            float floatValue = std::stof(valueStr);
-            setValue(key, floatValue);
-        } catch (const std::exception&) {
-            std::cerr << "Config: Type conversion error, key: " << key << std::endl;
-            // 为这些关键值设置默认值，避免游戏崩溃
-            if (key.find("_x") != std::string::npos || key.find("_y") != std::string::npos) {
-                setValue(key, 400.0f); // 默认位置
-            } else if (key.find("_vx") != std::string::npos || key.find("_vy") != std::string::npos) {
-                setValue(key, 0.0f);  // 默认速度
-            }
-        }
-    } else if (valueStr.find('.') != std::string::npos) {
-        // 浮点数
-        try {
-            float floatValue = std::stof(valueStr);
-            
-            // Check if the key suggests it should be a float
-            if (key.find("speed") != std::string::npos || 
-                key.find("volume") != std::string::npos ||
-                key.find("scale") != std::string::npos) {
-                setValue(key, floatValue);
-            } else {
-                // Try to determine if it's an int or float
-                int intValue = static_cast<int>(floatValue);
-                if (floatValue == static_cast<float>(intValue)) {
-                    setValue(key, intValue);
-                } else {
-                    setValue(key, floatValue);
-                }
-            }
-        } catch (const std::exception&) {
-            std::cerr << "config parse error: cannot convert " << valueStr << " to float" << std::endl;
+    while (field != table.end() || extra != extras.end()) {
+        const bool takeField = extra == extras.end() ||
+                               (field != table.end() && field->key < std::string_view(extra->first));
+        const std::string_view key = takeField ? field->key : std::string_view(extra->first);
+        
+        const std::string_view keySection = key.substr(0, key.find('.'));
+        if (keySection != section) {
+            file << "\n# " << keySection << " settings\n";
+            section = keySection;
         }
-    } else {
-        // 整数或可能是浮点数
-        try {
-            // First try as integer
-            int intValue = std::stoi(valueStr);
-            
-            // Check if the key suggests it should be a float
-            if (key.find("speed") != std::string::npos || 
-                key.find("volume") != std::string::npos ||
-                key.find("scale") != std::string::npos) {
-                setValue(key, static_cast<float>(intValue));
-            } else {
-                setValue(key, intValue);
-            }
-        } catch (const std::exception&) {
-            // If integer conversion fails, try as float
-            try {
-                float floatValue = std::stof(valueStr);
-                setValue(key, floatValue);
-            } catch (const std::exception&) {
-                std::cerr << "config parse error: cannot convert " << valueStr << " to int or float" << std::endl;
-            }
+        
+        file << key << " = ";
+        if (takeField) {
+            std::visit([this, &file](auto slot) { writeValue(file, settings.*slot); }, field->slot);
+            ++field;
+        } else {
+            writeAny(file, extra->second);
+            ++extra;
         }
+        file << "\n";
     }
 }
 
-sf::Vector2f Config::convertVector2f(const std::string& valueStr) {
-    std::istringstream iss(valueStr);
-    std::string xStr, yStr;
+std::any Config::getAny(std::string_view key) const {
+    if (const SettingField* field = findSetting(key)) {
+        return std::visit([this](auto slot) { return std::any(settings.*slot); }, field->slot);
+    }
     
-    if (std::getline(iss, xStr, ',') && std::getline(iss, yStr)) {
-        try {
-            float x = std::stof(xStr);
-            float y = std::stof(yStr);
-            return sf::Vector2f(x, y);
-        } catch (const std::exception&) {
-            std::cerr << "config parse error: cannot convert " << valueStr << " to Vector2f" << std::endl;
+    auto it = extras.find(key);
+    return it != extras.end() ? it->second : std::any();
+}
+
+void Config::setAny(std::string_view key, const std::any& value) {
+    if (const SettingField* field = findSetting(key)) {
+        bool ok = std::visit([this, &value](auto slot) { return readAny(value, settings.*slot); }, field->slot);
+        if (!ok) {
+            LOG_WARN(Config, "Type conversion error, key: %.*s", static_cast<int>(key.size()), key.data());
+            return;
         }
+        publish();
+        notify(field->key);
+        return;
     }
     
-    return sf::Vector2f(0, 0);
+    auto it = extras.find(key);
+    if (it != extras.end()) {
+        it->second = value;
+    } else {
+        extras.emplace(std::string(key), value);
+    }
 }
 
-sf::Color Config::convertColor(const std::string& valueStr) {
-    std::istringstream iss(valueStr);
-    std::string rStr, gStr, bStr, aStr;
-    
-    if (std::getline(iss, rStr, ',') && 
-        std::getline(iss, gStr, ',') && 
-        std::getline(iss, bStr, ',') && 
-        std::getline(iss, aStr)) {
-        try {
-            int r = std::stoi(rStr);
-            int g = std::stoi(gStr);
-            int b = std::stoi(bStr);
-            int a = std::stoi(aStr);
-            return sf::Color(
-                static_cast<std::uint8_t>(r),
-                static_cast<std::uint8_t>(g),
-                static_cast<std::uint8_t>(b),
-                static_cast<std::uint8_t>(a)
-            );
-        } catch (const std::exception&) {
-            std::cerr << "config parse error: cannot convert " << valueStr << " to Color" << std::endl;
+void Config::applySettings(const GameSettings& next) {
+    // 先找出变化的键，全部赋值之后再通知，回调里读到的是完整的新配置
+    std::vector<std::string_view> changed;
+    for (const auto& field : settingTable()) {
+        bool differs = std::visit([this, &next](auto slot) { return settings.*slot != next.*slot; }, field.slot);
+        if (differs) {
+            changed.push_back(field.key);
         }
     }
     
-    return sf::Color::White;
+    if (changed.empty()) {
+        return;
+    }
+    
+    settings = next;
+    publish();
+    for (std::string_view key : changed) {
+        notify(key);
+    }
 }
 
-template<>
-sf::Vector2f Config::convertValue<sf::Vector2f>(const std::string& valueStr) {
-    return convertVector2f(valueStr);
+void Config::notify(std::string_view key) {
+    // 按下标遍历（回调中新增的订阅会追加到末尾）；回调中取消的订阅只清空回调，全部通知完再删除，
+    // 这样后面的订阅者不会因为元素前移被跳过
+    ++notifyDepth;
+    for (std::size_t i = 0; i < subscribers.size(); ++i) {
+        if (subscribers[i].key == key && subscribers[i].notify) {
+            auto callback = subscribers[i].notify;
+            callback();
+        }
+    }
+    
+    if (--notifyDepth == 0) {
+        subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(),
+                                         [](const Subscriber& subscriber) { return !subscriber.notify; }),
+                          subscribers.end());
+    }
 }
 
-template<>
-sf::Color Config::convertValue<sf::Color>(const std::string& valueStr) {
-    return convertColor(valueStr);
+void Config::unsubscribe(int id) {
+    if (notifyDepth > 0) {
+        for (auto& subscriber : subscribers) {
+            if (subscriber.id == id) {
+                subscriber.notify = nullptr;
+            }
+        }
+        return;
+    }
+    
+    subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(),
+                                     [id](const Subscriber& subscriber) { return subscriber.id == id; }),
+                      subscribers.end());
 }
 
 bool Config::hasValue(const std::string& key) const {
-    return values.find(key) != values.end();
+    return findSetting(key) != nullptr || extras.find(key) != extras.end();
 }
 
 void Config::removeValue(const std::string& key) {
-    values.erase(key);
+    if (const SettingField* field = findSetting(key)) {
+        static const GameSettings defaults;
+        std::visit([this](auto slot) { settings.*slot = defaults.*slot; }, field->slot);
+        publish();
+        notify(field->key);
+        return;
+    }
+    extras.erase(key);
 }
 
 void Config::clear() {
-    values.clear();
+    settings = GameSettings{};
+    publish();
+    extras.clear();
 }
 
 void Config::setConfigFilePath(const std::string& path) {
     configFilePath = path;
 }
 
+const std::string& Config::getConfigFilePath() const {
+    return configFilePath;
+}
@@ -0,0 +1,137 @@
+#include "Utils/ConfigWatcher.h"
+#include "Utils/Config.h"
+#include "Utils/Tracer.h"
+#include "Utils/Logger.h"
+#include <chrono>
+#include <filesystem>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <climits>
+#include <cstring>
+#endif
+
+// Static member initialization
+ConfigWatcher* ConfigWatcher::s_instance = nullptr;
+
+ConfigWatcher::ConfigWatcher() : hasPending(false), stopping(false) {
+}
+
+ConfigWatcher::~ConfigWatcher() {
+    stop();
+}
+
+ConfigWatcher* ConfigWatcher::getInstance() {
+    if (s_instance == nullptr) {
+        s_instance = new ConfigWatcher();
+    }
+    return s_instance;
+}
+
+void ConfigWatcher::start(const std::string& file, const GameSettings& current) {
+    stop();
+    
+    filename = file;
+    base = std::make_shared<const GameSettings>(current);
+    stopping = false;
+    worker = std::thread(&ConfigWatcher::run, this);
+}
+
+void ConfigWatcher::stop() {
+    stopping = true;
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+bool ConfigWatcher::applyPending() {
+    if (!hasPending.load(std::memory_order_acquire)) {
+        return false;
+    }
+    hasPending.store(false, std::memory_order_relaxed);
+    
+    std::shared_ptr<const GameSettings> next = std::atomic_exchange(&pending, std::shared_ptr<const GameSettings>());
+    if (!next) {
+        return false;
+    }
+    
+    Config::getInstance().applySettings(*next);
+    LOG_INFO(Config, "Config reloaded: %s", filename.c_str());
+    return true;
+}
+
+void ConfigWatcher::reload() {
+    TRACE_SCOPE("ConfigWatcher::reload");
+    
+    // 在上次结果的拷贝上解析，发布之后这份快照不再修改
+    auto next = std::make_shared<GameSettings>(*base);
+    if (!Config::parseSettingsFile(filename, *next)) {
+        return; // 文件暂时不存在（例如正在被替换）
+    }
+    
+    base = next;
+    std::atomic_store(&pending, std::shared_ptr<const GameSettings>(next));
+    hasPending.store(true, std::memory_order_release);
+}
+
+void ConfigWatcher::run() {
+    TRACE_THREAD_NAME("config-watcher");
+    
+    namespace fs = std::filesystem;
+    const fs::path path(filename);
+
+#ifdef __linux__
+    // 监视所在目录：保存配置用的是 临时文件 + 重命名，文件本身的 inode 会变
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd >= 0) {
+        std::string directory = path.has_parent_path() ? path.parent_path().string() : ".";
+        const std::string name = path.filename().string();
+        if (inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) >= 0) {
+            alignas(inotify_event) char buffer[4096];
+            pollfd pfd{fd, POLLIN, 0};
+            
+            while (!stopping) {
+                // 超时醒来检查停止标志
+                if (poll(&pfd, 1, 200) <= 0) {
+                    continue;
+                }
+                
+                bool changed = false;
+                ssize_t length;
+                while ((length = read(fd, buffer, sizeof(buffer))) > 0) {
+                    for (char* p = buffer; p < buffer + length;) {
+                        const auto* event = reinterpret_cast<const inotify_event*>(p);
+                        if (event->len > 0 && name == event->name) {
+                            changed = true;
+                        }
+                        p += sizeof(inotify_event) + event->len;
+                    }
+                }
+                
+                if (changed) {
+                    reload();
+                }
+            }
+            close(fd);
+            return;
+        }
+        close(fd);
+    }
+    LOG_WARN(Config, "inotify unavailable, polling %s for changes", filename.c_str());
+#endif
+
+    // 其他平台：轮询修改时间
+    std::error_code error;
+    fs::file_time_type lastWrite = fs::last_write_time(path, error);
+    while (!stopping) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        
+        fs::file_time_type writeTime = fs::last_write_time(path, error);
+        if (!error && writeTime != lastWrite) {
+            lastWrite = writeTime;
+            reload();
+        }
+    }
+}
@@ -0,0 +1,159 @@
+#include "Utils/FlightRecorder.h"
+#include "Utils/SaveService.h"
+#include "Utils/AllocTracker.h"
+#include "Utils/Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <limits>
+#include <vector>
+
+// Static member initialization
+FlightRecorder* FlightRecorder::s_instance = nullptr;
+
+namespace {
+    const char* const eventNames[FlightRecorder::EventTypeCount] = {
+        "key_pressed", "key_released", "mouse_button", "ball_paddle", "ball_brick", "ball_wall", "ball_lost"
+    };
+    
+    // printf 格式追加到输出缓冲区
+    template<typename... Args>
+    void appendLine(std::vector<unsigned char>& out, const char* format, Args... args) {
+        char line[256];
+        int length = std::snprintf(line, sizeof(line), format, args...);
+        if (length > 0) {
+            out.insert(out.end(), line, line + std::min<std::size_t>(length, sizeof(line) - 1));
+        }
+    }
+}
+
+FlightRecorder::FlightRecorder()
+    : enabled(false),
+      budgetMs(0.0f),
+      windowSeconds(0.0f),
+      startTime(std::chrono::steady_clock::now()),
+      lastDumpTime(-std::numeric_limits<double>::infinity()),
+      frames{},
+      frameCount(0),
+      events{},
+      eventCount(0),
+      stateStack{},
+      stateDepth(0) {
+}
+
+FlightRecorder* FlightRecorder::getInstance() {
+    if (s_instance == nullptr) {
+        s_instance = new FlightRecorder();
+    }
+    return s_instance;
+}
+
+void FlightRecorder::configure(float budget, float seconds) {
+    enabled = budget > 0.0f;
+    budgetMs = budget;
+    windowSeconds = std::max(seconds, 0.5f);
+    
+    // 需要分阶段耗时，叠加层关闭时也让 FrameProfiler 统计
+    FrameProfiler::getInstance()->setRecording(enabled);
+}
+
+void FlightRecorder::pushState(const char* name) {
+    if (stateDepth < MaxStates) {
+        stateStack[stateDepth] = name;
+    }
+    ++stateDepth;
+}
+
+void FlightRecorder::popState() {
+    if (stateDepth > 0) {
+        --stateDepth;
+    }
+}
+
+void FlightRecorder::endFrame() {
+    if (!enabled) return;
+    
+    FrameRecord& record = frames[frameCount & (FrameCapacity - 1)];
+    record.frame = frameCount;
+    record.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    if (FrameProfiler::getInstance()->copyRecent(&record.sample, 1) == 0) {
+        record.sample = FrameProfiler::FrameSample{};
+    }
+    record.states = stateStack;
+    record.stateDepth = static_cast<std::uint8_t>(std::min(stateDepth, MaxStates));
+    ++frameCount;
+    
+    // 第一帧包含初始化不算；一次写出后，同一个窗口内的后续卡顿不再重复写
+    if (record.frame > 0 && record.sample.frameMs > budgetMs && record.time - lastDumpTime >= windowSeconds) {
+        lastDumpTime = record.time;
+        dump(record);
+    }
+}
+
+void FlightRecorder::dump(const FrameRecord& spike) {
+    AllocTracker::TagScope tag(AllocTracker::Debug);
+    
+    // 主线程只拷贝窗口内的记录，格式化和写盘在存档服务的线程中完成
+    std::vector<FrameRecord> window;
+    const std::uint64_t available = std::min<std::uint64_t>(frameCount, FrameCapacity);
+    for (std::uint64_t i = 0; i < available; ++i) {
+        const FrameRecord& record = frames[(frameCount - 1 - i) & (FrameCapacity - 1)];
+        if (spike.time - record.time > windowSeconds) break;
+        window.push_back(record);
+    }
+    std::reverse(window.begin(), window.end());
+    
+    std::vector<Event> windowEvents;
+    const std::uint64_t firstFrame = window.front().frame;
+    const std::uint64_t eventsAvailable = std::min<std::uint64_t>(eventCount, EventCapacity);
+    for (std::uint64_t i = eventCount - eventsAvailable; i < eventCount; ++i) {
+        const Event& event = events[i & (EventCapacity - 1)];
+        if (event.frame >= firstFrame) {
+            windowEvents.push_back(event);
+        }
+    }
+    
+    char filename[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(filename, sizeof(filename), "spike-%Y%m%d-%H%M%S.log", std::localtime(&now));
+    LOG_WARN(Diag, "Frame %llu took %.2f ms (budget %.2f ms), writing %s",
+             static_cast<unsigned long long>(spike.frame), spike.sample.frameMs, budgetMs, filename);
+    
+    const float budget = budgetMs;
+    const float seconds = windowSeconds;
+    SaveService::getInstance()->submit(filename,
+        [window = std::move(window), windowEvents = std::move(windowEvents), budget, seconds](std::vector<unsigned char>& out) {
+            const FrameRecord& last = window.back();
+            appendLine(out, "# frame %llu took %.2f ms (budget %.2f ms)\n",
+                       static_cast<unsigned long long>(last.frame), last.sample.frameMs, budget);
+            appendLine(out, "# %zu frames, %zu events, window %.1f s\n\n", window.size(), windowEvents.size(), seconds);
+            
+            appendLine(out, "%8s %9s %8s %8s %8s %8s %8s %8s %8s %6s %5s %6s %6s  %s\n",
+                       "frame", "time", "total", "events", "entities", "collide", "status", "render", "display",
+                       "draws", "balls", "bricks", "pairs", "states");
+            for (const FrameRecord& record : window) {
+                const FrameProfiler::FrameSample& sample = record.sample;
+                std::string states;
+                for (std::size_t i = 0; i < record.stateDepth; ++i) {
+                    states += i > 0 ? ">" : "";
+                    states += record.states[i];
+                }
+                appendLine(out, "%8llu %9.3f %8.2f %8.2f %8.2f %8.2f %8.2f %8.2f %8.2f %6u %5u %6u %6u  %s\n",
+                           static_cast<unsigned long long>(record.frame), record.time, sample.frameMs,
+                           sample.phaseMs[FrameProfiler::Events], sample.phaseMs[FrameProfiler::Entities],
+                           sample.phaseMs[FrameProfiler::Collision], sample.phaseMs[FrameProfiler::Status],
+                           sample.phaseMs[FrameProfiler::Render], sample.phaseMs[FrameProfiler::Display],
+                           sample.drawCalls, sample.balls, sample.bricks, sample.pairTests, states.c_str());
+            }
+            
+            appendLine(out, "\n%8s %-14s %8s %8s\n", "frame", "event", "a", "b");
+            for (const Event& event : windowEvents) {
+                appendLine(out, "%8llu %-14s %8d %8d\n", static_cast<unsigned long long>(event.frame),
+                           eventName(event.type), event.a, event.b);
+            }
+        });
+}
+
+const char* FlightRecorder::eventName(EventType type) {
+    return type < EventTypeCount ? eventNames[type] : "unknown";
+}
@@ -0,0 +1,88 @@
+#include "Utils/FrameArena.h"
+#include <algorithm>
+
+// Static member initialization
+FrameArena* FrameArena::s_instance = nullptr;
+
+namespace {
+    std::size_t alignUp(std::size_t value, std::size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+FrameArena::FrameArena(std::size_t capacity)
+    : block(new std::byte[capacity]),
+      capacity(capacity),
+      used(0),
+      overflow(nullptr),
+      overflowBytes(0),
+      lastFrameBytes(0),
+      peakBytes(0),
+      totalBytes(0),
+      frames(0),
+      overflowFrames(0) {
+}
+
+FrameArena::~FrameArena() {
+    releaseOverflow();
+}
+
+FrameArena* FrameArena::getInstance() {
+    if (s_instance == nullptr) {
+        s_instance = new FrameArena(DefaultCapacity);
+    }
+    return s_instance;
+}
+
+void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    // 主块按地址对齐（new[] 只保证基本对齐）
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.get());
+    const std::size_t offset = alignUp(base + used, alignment) - base;
+    if (offset + bytes <= capacity) {
+        used = offset + bytes;
+        return block.get() + offset;
+    }
+    
+    // 装不下：这一帧剩下的从上游分配，头部记下大小，reset 时释放
+    const std::size_t headerSize = alignUp(sizeof(Overflow), alignment);
+    const std::size_t chunkAlignment = std::max(alignment, alignof(Overflow));
+    std::byte* chunk = static_cast<std::byte*>(
+        std::pmr::new_delete_resource()->allocate(headerSize + bytes, chunkAlignment));
+    
+    // 头部放在返回地址的正前方
+    Overflow* header = reinterpret_cast<Overflow*>(chunk + headerSize - sizeof(Overflow));
+    header->next = overflow;
+    header->chunk = chunk;
+    header->size = headerSize + bytes;
+    header->alignment = chunkAlignment;
+    overflow = header;
+    overflowBytes += bytes;
+    return chunk + headerSize;
+}
+
+void FrameArena::releaseOverflow() {
+    while (overflow) {
+        Overflow* next = overflow->next;
+        std::pmr::new_delete_resource()->deallocate(overflow->chunk, overflow->size, overflow->alignment);
+        overflow = next;
+    }
+    overflowBytes = 0;
+}
+
+void FrameArena::reset() {
+    const std::size_t frameBytes = used + overflowBytes;
+    lastFrameBytes = frameBytes;
+    peakBytes = std::max(peakBytes, frameBytes);
+    totalBytes += frameBytes;
+    ++frames;
+    
+    if (overflow) {
+        ++overflowFrames;
+        releaseOverflow();
+        
+        // 扩大到峰值的两倍（按 4KB 取整），只在溢出后发生一次
+        capacity = alignUp(peakBytes * 2, 4096);
+        block.reset(new std::byte[capacity]);
+    }
+    used = 0;
+}
@@ -0,0 +1,202 @@
+#include "Utils/FrameProfiler.h"
+#include "Managers/AssetManager.h"
+#include "Utils/AllocTracker.h"
+#include "Utils/FrameArena.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+// Static member initialization
+FrameProfiler* FrameProfiler::s_instance = nullptr;
+
+namespace {
+    const char* const phaseNames[FrameProfiler::PhaseCount] = {
+        "events", "entities", "collision", "status", "render", "display"
+    };
+    
+    // 排好序的数组取分位数
+    float percentile(const FrameArena::Vector<float>& sorted, float fraction) {
+        if (sorted.empty()) return 0.0f;
+        std::size_t index = static_cast<std::size_t>(fraction * (sorted.size() - 1) + 0.5f);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+}
+
+FrameProfiler::FrameProfiler()
+    : enabled(false),
+      overlayVisible(false),
+      recording(false),
+      current{},
+      ring{},
+      head(0),
+      overlayTimer(0.0f) {
+}
+
+FrameProfiler* FrameProfiler::getInstance() {
+    if (s_instance == nullptr) {
+        s_instance = new FrameProfiler();
+    }
+    return s_instance;
+}
+
+void FrameProfiler::setOverlayVisible(bool value) {
+    overlayVisible = value;
+    overlayTimer = 0.0f;
+    updateEnabled();
+}
+
+void FrameProfiler::toggleOverlay() {
+    setOverlayVisible(!overlayVisible);
+}
+
+void FrameProfiler::setRecording(bool value) {
+    recording = value;
+    updateEnabled();
+}
+
+void FrameProfiler::updateEnabled() {
+    const bool value = overlayVisible || recording;
+    if (value && !enabled) {
+        // 从关闭切换过来时当前帧只从这里开始计时
+        current = FrameSample{};
+        frameStart = std::chrono::steady_clock::now();
+    }
+    enabled = value;
+}
+
+void FrameProfiler::beginFrame() {
+    if (!enabled) return;
+    
+    current = FrameSample{};
+    frameStart = std::chrono::steady_clock::now();
+}
+
+void FrameProfiler::endFrame() {
+    if (!enabled) return;
+    
+    std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - frameStart;
+    current.frameMs = elapsed.count();
+    
+    // 先写数据再发布 head
+    const std::uint64_t index = head.load(std::memory_order_relaxed);
+    ring[index & (Capacity - 1)] = current;
+    head.store(index + 1, std::memory_order_release);
+}
+
+void FrameProfiler::addPhaseTime(Phase phase, float milliseconds) {
+    current.phaseMs[phase] += milliseconds;
+}
+
+void FrameProfiler::setEntityCounts(std::uint32_t balls, std::uint32_t bricks) {
+    if (!enabled) return;
+    
+    current.balls = balls;
+    current.bricks = bricks;
+}
+
+std::size_t FrameProfiler::copyRecent(FrameSample* out, std::size_t maxCount) const {
+    const std::uint64_t end = head.load(std::memory_order_acquire);
+    std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(end, std::min(maxCount, Capacity)));
+    const std::uint64_t first = end - count;
+    
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = ring[(first + i) & (Capacity - 1)];
+    }
+    
+    // 复制期间写者可能绕回来覆盖了最旧的几帧，丢掉这些
+    const std::uint64_t after = head.load(std::memory_order_acquire);
+    const std::uint64_t oldestSafe = after > Capacity ? after - Capacity + 1 : 0;
+    if (first < oldestSafe) {
+        const std::size_t dropped = static_cast<std::size_t>(std::min<std::uint64_t>(oldestSafe - first, count));
+        std::memmove(out, out + dropped, (count - dropped) * sizeof(FrameSample));
+        count -= dropped;
+    }
+    return count;
+}
+
+void FrameProfiler::renderOverlay(sf::RenderWindow& window, float deltaTime) {
+    if (!overlayVisible) return;
+    
+    AllocTracker::TagScope tag(AllocTracker::Debug);
+    
+    if (!overlayText) {
+        if (!AssetManager::getInstance()->hasFont("arial")) return;
+        overlayText = std::make_unique<sf::Text>(AssetManager::getInstance()->getFont("arial"), "", 14);
+        overlayText->setFillColor(sf::Color::Green);
+        overlayText->setOutlineColor(sf::Color::Black);
+        overlayText->setOutlineThickness(1.0f);
+        overlayText->setPosition({10.0f, 70.0f});
+    }
+    
+    // 每0.25秒重新统计一次
+    overlayTimer -= deltaTime;
+    if (overlayTimer <= 0.0f) {
+        overlayTimer = 0.25f;
+        rebuildOverlay();
+    }
+    
+    window.draw(*overlayText);
+}
+
+void FrameProfiler::rebuildOverlay() {
+    // 临时数组和文字都从本帧的分配器分配
+    FrameArena* arena = FrameArena::getInstance();
+    FrameArena::Vector<FrameSample> samples(Capacity, arena);
+    samples.resize(copyRecent(samples.data(), samples.size()));
+    if (samples.empty()) {
+        overlayText->setString("collecting...");
+        return;
+    }
+    
+    FrameArena::String text(arena);
+    text.reserve(1024);
+    char line[128];
+    FrameArena::Vector<float> values(samples.size(), arena);
+    
+    std::snprintf(line, sizeof(line), "%-10s %6s %6s %6s %6s  (ms, %zu frames)\n",
+                  "", "p50", "p95", "p99", "max", samples.size());
+    text += line;
+    
+    // 第一行是整帧，后面每个阶段一行
+    for (int row = -1; row < PhaseCount; ++row) {
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            values[i] = row < 0 ? samples[i].frameMs : samples[i].phaseMs[row];
+        }
+        std::sort(values.begin(), values.end());
+        
+        std::snprintf(line, sizeof(line), "%-10s %6.2f %6.2f %6.2f %6.2f\n",
+                      row < 0 ? "frame" : phaseNames[row],
+                      percentile(values, 0.50f), percentile(values, 0.95f),
+                      percentile(values, 0.99f), values.back());
+        text += line;
+    }
+    
+    const FrameSample& last = samples.back();
+    std::snprintf(line, sizeof(line), "draws %u  balls %u  bricks %u  pair tests %u",
+                  last.drawCalls, last.balls, last.bricks, last.pairTests);
+    text += line;
+    
+    // 上一帧的分配（按标签）
+    if (AllocTracker::isAvailable()) {
+        const AllocTracker::FrameStats& allocs = AllocTracker::getLastFrame();
+        std::snprintf(line, sizeof(line), "\nallocs %llu (%llu B):",
+                      static_cast<unsigned long long>(allocs.total.allocations),
+                      static_cast<unsigned long long>(allocs.total.bytes));
+        text += line;
+        for (int tag = 0; tag < AllocTracker::TagCount; ++tag) {
+            if (allocs.tags[tag].allocations > 0) {
+                std::snprintf(line, sizeof(line), " %s %llu", AllocTracker::tagName(static_cast<AllocTracker::Tag>(tag)),
+                              static_cast<unsigned long long>(allocs.tags[tag].allocations));
+                text += line;
+            }
+        }
+    }
+    
+    // 本帧分配器的用量
+    std::snprintf(line, sizeof(line), "\narena %zu KB  peak %zu KB  avg %zu KB  cap %zu KB",
+                  arena->getLastFrameBytes() / 1024, arena->getPeakBytes() / 1024,
+                  arena->getAverageBytes() / 1024, arena->getCapacity() / 1024);
+    text += line;
+    
+    overlayText->setString(sf::String::fromUtf8(text.begin(), text.end()));
+}
@@ -0,0 +1,275 @@
+#include "Utils/Logger.h"
+#include "Utils/Tracer.h"
+
+// Static member initialization
+Logger* Logger::s_instance = nullptr;
+std::atomic<std::uint32_t> Logger::nextThreadId(1);
+thread_local std::uint32_t Logger::t_threadId = 0;
+
+namespace {
+    // 写线程空闲时每隔这么久检查一次队列（error 会立即唤醒）
+    const std::chrono::milliseconds pollInterval(20);
+    
+    const char* const levelNames[Logger::LevelCount] = {
+        "trace", "debug", "info", "warning", "error"
+    };
+    
+    const char* const categoryNames[Logger::CategoryCount] = {
+        "core", "assets", "audio", "levels", "save", "config", "diag"
+    };
+}
+
+Logger::Logger()
+    : minLevel(Info),
+      rateLimit(10),
+      origin(std::chrono::steady_clock::now()),
+      slots(new Slot[QueueCapacity]),
+      tail(0),
+      head(0),
+      dropped(0),
+      droppedReported(0),
+      stopping(false),
+      started(false),
+      stopped(false),
+      file(nullptr) {
+    for (std::size_t i = 0; i < QueueCapacity; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+Logger::~Logger() {
+    shutdown();
+}
+
+Logger* Logger::getInstance() {
+    if (s_instance == nullptr) {
+        s_instance = new Logger();
+    }
+    return s_instance;
+}
+
+bool Logger::setFile(const std::string& filename) {
+    std::FILE* opened = nullptr;
+    if (!filename.empty()) {
+        opened = std::fopen(filename.c_str(), "ab");
+        if (!opened) {
+            LOG_ERROR(Diag, "Failed to open log file: %s", filename.c_str());
+            return false;
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(fileMutex);
+    if (file) {
+        std::fclose(file);
+    }
+    file = opened;
+    return true;
+}
+
+double Logger::seconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - origin).count();
+}
+
+bool Logger::admit(CallSite& site, std::uint32_t& suppressed) {
+    const std::uint32_t limit = rateLimit.load(std::memory_order_relaxed);
+    if (limit == 0) {
+        return true;
+    }
+    
+    // 每个调用点一秒一个窗口；新窗口的第一条消息带上上个窗口被丢掉的条数
+    const std::int64_t now = static_cast<std::int64_t>(seconds() * 1000.0);
+    std::int64_t start = site.windowStart.load(std::memory_order_relaxed);
+    if (now - start >= 1000 && site.windowStart.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+        site.count.store(0, std::memory_order_relaxed);
+        suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+    }
+    
+    if (site.count.fetch_add(1, std::memory_order_relaxed) < limit) {
+        return true;
+    }
+    site.suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+Logger::Slot* Logger::claim(std::uint64_t& position) {
+    if (!started.load(std::memory_order_acquire)) {
+        startWriter();
+    }
+    
+    // 有界多写者队列：槽位的序号等于写入位置时可以占用
+    position = tail.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots[position & (QueueCapacity - 1)];
+        const std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const std::int64_t difference = static_cast<std::int64_t>(sequence - position);
+        if (difference == 0) {
+            if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                return &slot;
+            }
+        } else if (difference < 0) {
+            // 写线程还没读走一圈前的消息：队列满
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        } else {
+            position = tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::publish(Slot* slot, std::uint64_t position, Level level, Category category, std::uint32_t suppressed) {
+    if (t_threadId == 0) {
+        t_threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    slot->time = seconds();
+    slot->thread = t_threadId;
+    slot->suppressed = suppressed;
+    slot->level = level;
+    slot->category = category;
+    slot->sequence.store(position + 1, std::memory_order_release);
+    
+    // 错误立即写出，队列每写满一半也唤醒一次；其他消息等下一次轮询
+    // （通知不加锁，错过了也只晚一个轮询周期）
+    if (level >= Error || (position & (QueueCapacity / 2 - 1)) == QueueCapacity / 2 - 1) {
+        wake.notify_one();
+    }
+}
+
+void Logger::writeNow(Level level, Category category, std::uint32_t suppressed, const char* text) {
+    if (t_threadId == 0) {
+        t_threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    std::lock_guard<std::mutex> lock(fileMutex);
+    emit(seconds(), t_threadId, level, category, suppressed, text);
+    std::fflush(level >= Warning ? stderr : stdout);
+    if (file) {
+        std::fflush(file);
+    }
+}
+
+void Logger::startWriter() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (started.load(std::memory_order_relaxed) || stopped.load(std::memory_order_relaxed)) {
+        return;
+    }
+    stopping = false;
+    writer = std::thread(&Logger::run, this);
+    started.store(true, std::memory_order_release);
+}
+
+void Logger::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped.store(true, std::memory_order_release);
+        stopping = true;
+    }
+    wake.notify_one();
+    if (writer.joinable()) {
+        writer.join();
+    }
+    
+    std::lock_guard<std::mutex> lock(fileMutex);
+    if (file) {
+        std::fflush(file);
+    }
+}
+
+void Logger::run() {
+    TRACE_THREAD_NAME("log");
+    std::unique_lock<std::mutex> lock(mutex);
+    
+    bool done = false;
+    while (!done) {
+        wake.wait_for(lock, pollInterval, [this]() { return stopping; });
+        done = stopping; // 停止前最后再写一次
+        
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+}
+
+void Logger::drain() {
+    std::lock_guard<std::mutex> lock(fileMutex);
+    
+    bool wroteOut = false;
+    bool wroteErr = false;
+    for (;;) {
+        Slot& slot = slots[head & (QueueCapacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != head + 1) {
+            break;
+        }
+        
+        emit(slot.time, slot.thread, slot.level, slot.category, slot.suppressed, slot.text);
+        (slot.level >= Warning ? wroteErr : wroteOut) = true;
+        
+        // 槽位交还给下一圈的写入者
+        slot.sequence.store(head + QueueCapacity, std::memory_order_release);
+        ++head;
+    }
+    
+    const std::uint64_t droppedNow = dropped.load(std::memory_order_relaxed);
+    if (droppedNow != droppedReported) {
+        char text[MessageSize];
+        std::snprintf(text, sizeof(text), "%llu messages dropped (log queue full)",
+                      static_cast<unsigned long long>(droppedNow - droppedReported));
+        droppedReported = droppedNow;
+        emit(seconds(), 0, Warning, Diag, 0, text);
+        wroteErr = true;
+    }
+    
+    // 一批消息只刷新一次
+    if (wroteOut) std::fflush(stdout);
+    if (wroteErr) std::fflush(stderr);
+    if (file && (wroteOut || wroteErr)) std::fflush(file);
+}
+
+void Logger::emit(double time, std::uint32_t thread, Level level, Category category, std::uint32_t suppressed,
+                  const char* text) {
+    // [时间] 级别 分类 #线程: 消息
+    char prefix[96];
+    int length;
+    if (suppressed > 0) {
+        length = std::snprintf(prefix, sizeof(prefix), "[%10.3f] %-7s %-6s #%u: (%u similar suppressed) ",
+                               time, levelName(level), categoryName(category), thread, suppressed);
+    } else {
+        length = std::snprintf(prefix, sizeof(prefix), "[%10.3f] %-7s %-6s #%u: ",
+                               time, levelName(level), categoryName(category), thread);
+    }
+    if (length < 0) {
+        return;
+    }
+    
+    std::FILE* console = level >= Warning ? stderr : stdout;
+    std::fputs(prefix, console);
+    std::fputs(text, console);
+    std::fputc('\n', console);
+    if (file) {
+        std::fputs(prefix, file);
+        std::fputs(text, file);
+        std::fputc('\n', file);
+    }
+}
+
+bool Logger::parseLevel(const std::string& text, Level& level) {
+    for (int i = 0; i < LevelCount; ++i) {
+        if (text == levelNames[i]) {
+            level = static_cast<Level>(i);
+            return true;
+        }
+    }
+    if (text == "warn") {
+        level = Warning;
+        return true;
+    }
+    return false;
+}
+
+const char* Logger::levelName(Level level) {
+    return level < LevelCount ? levelNames[level] : "unknown";
+}
+
+const char* Logger::categoryName(Category category) {
+    return category < CategoryCount ? categoryNames[category] : "unknown";
+}
@@ -0,0 +1,262 @@
+#include "Utils/SaveService.h"
+#include "Utils/Tracer.h"
+#include "Utils/AllocTracker.h"
+#include "Utils/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Static member initialization
+SaveService* SaveService::s_instance = nullptr;
+
+namespace {
+    // 每次写入用不同的临时文件名（进程号 + 序号），同步写和后台任务写同一个文件时不会互相截断
+    std::string makeTempName(const std::string& filename) {
+        static std::atomic<unsigned long> counter{0};
+#ifdef _WIN32
+        unsigned long pid = static_cast<unsigned long>(GetCurrentProcessId());
+#else
+        unsigned long pid = static_cast<unsigned long>(::getpid());
+#endif
+        return filename + "." + std::to_string(pid) + "." + std::to_string(++counter) + ".tmp";
+    }
+}
+
+SaveService::SaveService() : busy(false), stopping(false) {
+}
+
+SaveService::~SaveService() {
+    shutdown();
+}
+
+SaveService* SaveService::getInstance() {
+    if (s_instance == nullptr) {
+        s_instance = new SaveService();
+    }
+    return s_instance;
+}
+
+void SaveService::submit(const std::string& filename, Serializer serializer) {
+    AllocTracker::TagScope tag(AllocTracker::Save);
+    enqueue({filename, std::move(serializer), {}});
+}
+
+void SaveService::append(const std::string& filename, const void* data, std::size_t size) {
+    AllocTracker::TagScope tag(AllocTracker::Save);
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    enqueue({filename, nullptr, std::vector<unsigned char>(bytes, bytes + size)});
+}
+
+void SaveService::enqueue(Job job) {
+    std::unique_lock<std::mutex> lock(mutex);
+    
+    if (stopping) {
+        // 已经停止：直接在调用线程中写
+        lock.unlock();
+        std::vector<unsigned char> local;
+        write(job, local);
+        return;
+    }
+    
+    if (job.serialize) {
+        // 整个文件都会被替换，同一文件还没开始写的任务（包括追加）都不需要了
+        pending.erase(std::remove_if(pending.begin(), pending.end(),
+                                     [&job](const Job& other) { return other.filename == job.filename; }),
+                      pending.end());
+        pending.push_back(std::move(job));
+    } else {
+        // 同一文件最后一个任务也是追加时直接拼在后面
+        auto last = std::find_if(pending.rbegin(), pending.rend(),
+                                 [&job](const Job& other) { return other.filename == job.filename; });
+        if (last != pending.rend() && !last->serialize) {
+            last->appendData.insert(last->appendData.end(), job.appendData.begin(), job.appendData.end());
+        } else {
+            pending.push_back(std::move(job));
+        }
+    }
+    
+    if (!worker.joinable()) {
+        worker = std::thread(&SaveService::run, this);
+    }
+    wake.notify_one();
+}
+
+void SaveService::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return pending.empty() && !busy; });
+}
+
+void SaveService::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void SaveService::run() {
+    TRACE_THREAD_NAME("save");
+
+    std::vector<Job> jobs;
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+        wake.wait(lock, [this]() { return stopping || !pending.empty(); });
+        if (pending.empty()) {
+            break; // stopping，且没有剩余任务
+        }
+
+        jobs.swap(pending);
+        busy = true;
+        lock.unlock();
+
+        for (const auto& job : jobs) {
+            write(job, buffer);
+        }
+        jobs.clear();
+
+        lock.lock();
+        busy = false;
+        if (pending.empty()) {
+            idle.notify_all();
+        }
+    }
+
+    idle.notify_all();
+}
+
+void SaveService::write(const Job& job, std::vector<unsigned char>& out) {
+    TRACE_SCOPE_DETAIL("SaveService::write", job.filename.c_str());
+    
+    bool ok;
+    if (job.serialize) {
+        out.clear();
+        job.serialize(out);
+        ok = writeAtomically(job.filename, out.data(), out.size());
+    } else {
+        ok = appendDurably(job.filename, job.appendData.data(), job.appendData.size());
+    }
+    
+    if (!ok) {
+        LOG_ERROR(Save, "Failed to save %s", job.filename.c_str());
+    }
+}
+
+bool SaveService::writeAtomically(const std::string& filename, const void* data, std::size_t size) {
+    const std::string tempName = makeTempName(filename);
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(tempName.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    DWORD written = 0;
+    bool ok = WriteFile(file, data, static_cast<DWORD>(size), &written, nullptr) &&
+              written == size && FlushFileBuffers(file);
+    CloseHandle(file);
+
+    if (!ok || !MoveFileExA(tempName.c_str(), filename.c_str(),
+                            MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        DeleteFileA(tempName.c_str());
+        return false;
+    }
+    return true;
+#else
+    int fd = ::open(tempName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        LOG_ERROR(Save, "Cannot create %s: %s", tempName.c_str(), std::strerror(errno));
+        return false;
+    }
+
+    const char* bytes = static_cast<const char*>(data);
+    std::size_t remaining = size;
+    bool ok = true;
+    while (remaining > 0) {
+        ssize_t n = ::write(fd, bytes, remaining);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            ok = false;
+            break;
+        }
+        bytes += n;
+        remaining -= static_cast<std::size_t>(n);
+    }
+
+    // 数据落盘之后才重命名，保证新文件名指向的一定是完整内容
+    ok = ok && ::fsync(fd) == 0;
+    ok = ::close(fd) == 0 && ok;
+
+    if (!ok || ::rename(tempName.c_str(), filename.c_str()) != 0) {
+        LOG_ERROR(Save, "Cannot write %s: %s", filename.c_str(), std::strerror(errno));
+        ::unlink(tempName.c_str());
+        return false;
+    }
+
+    // 同步所在目录，让重命名本身也落盘
+    std::string::size_type slash = filename.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : filename.substr(0, slash + 1);
+    int dirFd = ::open(directory.c_str(), O_RDONLY);
+    if (dirFd >= 0) {
+        ::fsync(dirFd);
+        ::close(dirFd);
+    }
+    return true;
+#endif
+}
+
+bool SaveService::appendDurably(const std::string& filename, const void* data, std::size_t size) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ, nullptr, OPEN_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    DWORD written = 0;
+    bool ok = WriteFile(file, data, static_cast<DWORD>(size), &written, nullptr) &&
+              written == size && FlushFileBuffers(file);
+    CloseHandle(file);
+    return ok;
+#else
+    int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        LOG_ERROR(Save, "Cannot open %s: %s", filename.c_str(), std::strerror(errno));
+        return false;
+    }
+
+    const char* bytes = static_cast<const char*>(data);
+    std::size_t remaining = size;
+    bool ok = true;
+    while (remaining > 0) {
+        ssize_t n = ::write(fd, bytes, remaining);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            ok = false;
+            break;
+        }
+        bytes += n;
+        remaining -= static_cast<std::size_t>(n);
+    }
+
+    ok = ok && ::fsync(fd) == 0;
+    ok = ::close(fd) == 0 && ok;
+    return ok;
+#endif
+}
@@ -0,0 +1,291 @@
+#include "Utils/Tracer.h"
+#include "Utils/AllocTracker.h"
+#include "Utils/Logger.h"
+
+// Static member initialization
+Tracer* Tracer::s_instance = nullptr;
+thread_local Tracer::ThreadSlot Tracer::t_slot;
+
+namespace {
+    // 后台线程每隔这么久把各线程的缓冲区写进文件
+    const std::chrono::milliseconds flushInterval(250);
+    
+    void writeEscaped(std::FILE* file, const char* text) {
+        for (const char* p = text; *p; ++p) {
+            unsigned char c = static_cast<unsigned char>(*p);
+            if (c == '"' || c == '\\') {
+                std::fputc('\\', file);
+                std::fputc(c, file);
+            } else if (c < 0x20) {
+                std::fprintf(file, "\\u%04x", c);
+            } else {
+                std::fputc(c, file);
+            }
+        }
+    }
+}
+
+Tracer::Tracer()
+    : enabled(false),
+      file(nullptr),
+      firstEvent(true),
+      nextTid(0),
+      stopping(false) {
+}
+
+Tracer::~Tracer() {
+    stop();
+}
+
+Tracer* Tracer::getInstance() {
+    if (s_instance == nullptr) {
+        s_instance = new Tracer();
+    }
+    return s_instance;
+}
+
+bool Tracer::start(const std::string& filename) {
+    stop();
+    
+    file = std::fopen(filename.c_str(), "wb");
+    if (!file) {
+        LOG_ERROR(Diag, "Failed to open trace file: %s", filename.c_str());
+        return false;
+    }
+    
+    // 数组格式：程序崩溃时缺少结尾的 ] 也能打开
+    std::fputs("[\n", file);
+    firstEvent = true;
+    
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (auto& buffer : buffers) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            buffer->events.clear();
+            buffer->nameWritten = false;
+            if (buffer->released) {
+                // 上次停止时还没写完的已退出线程，事件已丢弃，直接回收
+                buffer->released = false;
+                buffer->threadName = nullptr;
+                freeBuffers.push_back(buffer.get());
+            }
+        }
+    }
+    
+    origin = std::chrono::steady_clock::now();
+    stopping = false;
+    writer = std::thread(&Tracer::run, this);
+    enabled.store(true, std::memory_order_release);
+    
+    LOG_INFO(Diag, "Tracing to %s", filename.c_str());
+    return true;
+}
+
+void Tracer::stop() {
+    if (!writer.joinable()) {
+        return;
+    }
+    
+    enabled.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+    
+    std::fputs("\n]\n", file);
+    std::fclose(file);
+    file = nullptr;
+}
+
+std::int64_t Tracer::now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+void Tracer::complete(const char* name, std::int64_t start, const char* detail) {
+    const std::int64_t end = now();
+    record('X', name, start, end - start, detail);
+}
+
+void Tracer::counter(const char* name, std::int64_t value) {
+    if (!isEnabled()) return;
+    record('C', name, now(), value, nullptr);
+}
+
+void Tracer::instant(const char* name, const char* detail) {
+    if (!isEnabled()) return;
+    record('i', name, now(), 0, detail);
+}
+
+void Tracer::setThreadName(const char* name) {
+    // 追踪关闭时不分配缓冲区：每次 std::async 都是新线程，名字只记在线程局部变量里
+    t_slot.name = name;
+    if (t_slot.buffer != nullptr) {
+        std::lock_guard<std::mutex> lock(t_slot.buffer->mutex);
+        t_slot.buffer->threadName = name;
+        t_slot.buffer->nameWritten = false;
+    }
+}
+
+Tracer::ThreadBuffer& Tracer::localBuffer() {
+    if (t_slot.buffer == nullptr) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        ThreadBuffer* buffer = nullptr;
+        if (!freeBuffers.empty()) {
+            // 复用已退出线程的缓冲区（连同 events 的容量）
+            buffer = freeBuffers.back();
+            freeBuffers.pop_back();
+        } else {
+            buffers.push_back(std::make_unique<ThreadBuffer>());
+            buffer = buffers.back().get();
+        }
+        
+        // 换一个新的 tid，追踪文件里不同线程不会混在一起
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->tid = ++nextTid;
+        buffer->threadName = t_slot.name;
+        buffer->nameWritten = false;
+        buffer->released = false;
+        t_slot.buffer = buffer;
+    }
+    return *t_slot.buffer;
+}
+
+void Tracer::releaseBuffer(ThreadBuffer* buffer) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+    if (buffer->events.empty()) {
+        buffer->threadName = nullptr;
+        freeBuffers.push_back(buffer);
+    } else {
+        buffer->released = true; // 写文件线程写完剩余事件后回收
+    }
+}
+
+Tracer::ThreadSlot::~ThreadSlot() {
+    if (buffer != nullptr) {
+        Tracer::getInstance()->releaseBuffer(buffer);
+    }
+}
+
+void Tracer::record(char phase, const char* name, std::int64_t timestamp, std::int64_t value, const char* detail) {
+    if (!isEnabled()) return;
+    
+    Event event;
+    event.name = name;
+    event.timestamp = timestamp;
+    event.value = value;
+    event.phase = phase;
+    event.detail[0] = '\0';
+    if (detail) {
+        std::size_t length = 0;
+        while (detail[length] && length < sizeof(event.detail) - 1) {
+            event.detail[length] = detail[length];
+            ++length;
+        }
+        event.detail[length] = '\0';
+    }
+    
+    AllocTracker::TagScope tag(AllocTracker::Debug);
+    ThreadBuffer& buffer = localBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events.push_back(event);
+}
+
+void Tracer::run() {
+    std::vector<Event> scratch;
+    std::unique_lock<std::mutex> lock(writerMutex);
+    
+    bool done = false;
+    while (!done) {
+        wake.wait_for(lock, flushInterval, [this]() { return stopping; });
+        done = stopping; // 停止前最后再写一次
+        
+        lock.unlock();
+        drain(scratch);
+        lock.lock();
+    }
+}
+
+void Tracer::drain(std::vector<Event>& scratch) {
+    std::vector<ThreadBuffer*> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        snapshot.reserve(buffers.size());
+        for (auto& buffer : buffers) {
+            snapshot.push_back(buffer.get());
+        }
+    }
+    
+    for (ThreadBuffer* buffer : snapshot) {
+        const char* threadName = nullptr;
+        std::uint32_t tid = 0;
+        {
+            // 交换后线程继续写入上次清空的 vector，稳定后不再分配
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            scratch.swap(buffer->events);
+            tid = buffer->tid; // 线程退出后缓冲区可能马上换给别的线程
+            if (buffer->threadName && !buffer->nameWritten) {
+                threadName = buffer->threadName;
+                buffer->nameWritten = true;
+            }
+        }
+        
+        if (threadName) {
+            writeThreadName(threadName, tid);
+        }
+        for (const Event& event : scratch) {
+            writeEvent(event, tid);
+        }
+        scratch.clear();
+        
+        std::lock_guard<std::mutex> lock(registryMutex);
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        if (buffer->released && buffer->events.empty()) {
+            buffer->released = false;
+            buffer->threadName = nullptr;
+            freeBuffers.push_back(buffer);
+        }
+    }
+    
+    std::fflush(file);
+}
+
+void Tracer::writeEvent(const Event& event, std::uint32_t tid) {
+    std::fputs(firstEvent ? "" : ",\n", file);
+    firstEvent = false;
+    
+    std::fputs("{\"name\":\"", file);
+    writeEscaped(file, event.name);
+    std::fprintf(file, "\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u",
+                 event.phase, event.timestamp / 1000.0, tid);
+    
+    switch (event.phase) {
+        case 'X':
+            std::fprintf(file, ",\"dur\":%.3f", event.value / 1000.0);
+            break;
+        case 'C':
+            std::fprintf(file, ",\"args\":{\"value\":%lld}", static_cast<long long>(event.value));
+            break;
+        case 'i':
+            std::fputs(",\"s\":\"t\"", file);
+            break;
+    }
+    
+    if (event.detail[0] != '\0') {
+        std::fputs(",\"args\":{\"detail\":\"", file);
+        writeEscaped(file, event.detail);
+        std::fputs("\"}", file);
+    }
+    std::fputc('}', file);
+}
+
+void Tracer::writeThreadName(const char* name, std::uint32_t tid) {
+    std::fputs(firstEvent ? "" : ",\n", file);
+    firstEvent = false;
+    
+    std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", tid);
+    writeEscaped(file, name);
+    std::fputs("\"}}", file);
+}
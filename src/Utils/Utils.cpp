@@ -7,14 +7,22 @@
 #include <iomanip>
 
 // 初始化静态成员
-std::mt19937 Utils::Random::generator;
+Utils::Random::Engine Utils::Random::generator;
 std::chrono::steady_clock::time_point Utils::Time::startTime;
 
 // Random class implementation
 void Utils::Random::init() {
     // Use random device as seed
     std::random_device rd;
-    generator.seed(rd());
+    generator.setState((static_cast<std::uint64_t>(rd()) << 32) | rd());
+}
+
+std::uint64_t Utils::Random::getState() {
+    return generator.getState();
+}
+
+void Utils::Random::setState(std::uint64_t state) {
+    generator.setState(state);
 }
 
 int Utils::Random::getInt(int min, int max) {
@@ -1,23 +1,33 @@
 #include "Game.h"
-#include "Utils/Config.h"
 #include <iostream>
 #include <exception>
+#include <cstdlib>
+#include <cstring>
 
-int main() {
-    // 初始化配置
-    Config& config = Config::getInstance();
-    
+int main(int argc, char* argv[]) {
     // 创建游戏实例
     Game game;
     
+    // --alloc-test [秒数]：自动游戏，稳态中有分配时返回非零值
+    // --autopilot：自动挡板一直玩下去（挂机测试），快进倍数见 debug.simulation_speed
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--alloc-test") == 0) {
+            float seconds = (i + 1 < argc) ? static_cast<float>(std::atof(argv[i + 1])) : 0.0f;
+            game.setAllocationTest(seconds > 0.0f ? seconds : 20.0f);
+        }
+        if (std::strcmp(argv[i], "--autopilot") == 0) {
+            game.setAutopilot(true);
+        }
+    }
+    
     // 初始化游戏
     game.init();
+    if (game.getExitCode() != 0) {
+        return game.getExitCode();
+    }
     
-    // 运行游戏
+    // 运行游戏（配置在 ~Game 中提交到后台存档线程，等它写完后退出）
     game.run();
     
-    // 保存配置
-    config.save();
-    
-    return 0;
+    return game.getExitCode();
 }
\ No newline at end of file
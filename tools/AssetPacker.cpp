@@ -0,0 +1,113 @@
+// 资源打包工具：把若干目录下的松散资源文件打成一个 .pak 文件
+// 用法：AssetPacker <output.pak> <dir|file> [<dir|file> ...]
+// 包内路径与运行时传给 AssetManager 的路径一致（相对当前工作目录，'/' 分隔）
+#include "Managers/AssetPack.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    struct PackInput {
+        std::string packPath;
+        fs::path sourcePath;
+        std::uint64_t size;
+    };
+
+    std::uint64_t alignUp(std::uint64_t value, std::uint64_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    bool addFile(std::vector<PackInput>& inputs, const fs::path& path) {
+        std::string packPath = path.lexically_normal().generic_string();
+        if (packPath.size() >= AssetPackFormat::MaxPathLength) {
+            std::cerr << "Path too long for asset pack: " << packPath << std::endl;
+            return false;
+        }
+        inputs.push_back({packPath, path, static_cast<std::uint64_t>(fs::file_size(path))});
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <output.pak> <dir|file> [<dir|file> ...]" << std::endl;
+        return 1;
+    }
+
+    std::vector<PackInput> inputs;
+    for (int i = 2; i < argc; ++i) {
+        fs::path root(argv[i]);
+        if (fs::is_regular_file(root)) {
+            if (!addFile(inputs, root)) return 1;
+        } else if (fs::is_directory(root)) {
+            for (const auto& entry : fs::recursive_directory_iterator(root)) {
+                if (entry.is_regular_file() && !addFile(inputs, entry.path())) return 1;
+            }
+        } else {
+            std::cerr << "No such file or directory: " << root.string() << std::endl;
+            return 1;
+        }
+    }
+
+    // 索引按路径排序，运行时二分查找
+    std::sort(inputs.begin(), inputs.end(), [](const PackInput& a, const PackInput& b) {
+        return a.packPath < b.packPath;
+    });
+
+    using namespace AssetPackFormat;
+    Header header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.entryCount = static_cast<std::uint32_t>(inputs.size());
+    header.indexOffset = sizeof(Header);
+
+    std::vector<Entry> entries(inputs.size());
+    std::uint64_t offset = alignUp(header.indexOffset + entries.size() * sizeof(Entry), BlobAlignment);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        std::memset(&entries[i], 0, sizeof(Entry));
+        std::memcpy(entries[i].path, inputs[i].packPath.c_str(), inputs[i].packPath.size());
+        entries[i].offset = offset;
+        entries[i].size = inputs[i].size;
+        offset = alignUp(offset + inputs[i].size, BlobAlignment);
+    }
+
+    std::ofstream out(argv[1], std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Cannot create asset pack: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(Entry)));
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        // 用零填充到对齐位置
+        std::uint64_t position = static_cast<std::uint64_t>(out.tellp());
+        std::vector<char> padding(static_cast<size_t>(entries[i].offset - position), 0);
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+        std::ifstream in(inputs[i].sourcePath, std::ios::binary);
+        std::vector<char> content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (!in.good() && !in.eof()) {
+            std::cerr << "Cannot read " << inputs[i].sourcePath.string() << std::endl;
+            return 1;
+        }
+        out.write(content.data(), static_cast<std::streamsize>(content.size()));
+        std::cout << "Packed " << inputs[i].packPath << " (" << content.size() << " bytes)" << std::endl;
+    }
+
+    if (!out.good()) {
+        std::cerr << "Failed to write asset pack: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::cout << "Wrote " << inputs.size() << " assets to " << argv[1] << std::endl;
+    return 0;
+}
@@ -0,0 +1,51 @@
+// 关卡编译工具：把文本关卡编译成二进制 .bbl 格式
+// 用法：LevelCompiler <levelN.txt> [<levelM.txt> ...]
+// 输出文件与输入同名，扩展名为 .bbl
+#include "Managers/LevelFormat.h"
+#include "Managers/LevelParser.h"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+namespace {
+    bool compileLevel(const std::string& inputPath) {
+        std::ifstream input(inputPath, std::ios::binary);
+        if (!input.is_open()) {
+            std::cerr << "Cannot open level file: " << inputPath << std::endl;
+            return false;
+        }
+        std::string text((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+        LevelParser::Layout layout;
+        LevelParser::Error error;
+        if (!LevelParser::parse(text.data(), text.size(), layout, error)) {
+            std::cerr << inputPath << ":" << error.line << ":" << error.column << ": " << error.message << std::endl;
+            return false;
+        }
+
+        const auto& records = layout.records;
+        std::string outputPath = LevelFormat::compiledPath(inputPath);
+        if (!LevelFormat::writeFile(outputPath, layout.rows, layout.columns, records.data(), records.size())) {
+            std::cerr << "Failed to write compiled level: " << outputPath << std::endl;
+            return false;
+        }
+
+        std::cout << "Compiled " << inputPath << " -> " << outputPath << " (" << layout.rows << "x" << layout.columns
+                  << ", " << records.size() << " bricks)" << std::endl;
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <level.txt> [<level.txt> ...]" << std::endl;
+        return 1;
+    }
+
+    bool ok = true;
+    for (int i = 1; i < argc; ++i) {
+        ok = compileLevel(argv[i]) && ok;
+    }
+    return ok ? 0 : 1;
+}